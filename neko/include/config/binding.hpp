@@ -0,0 +1,189 @@
+//
+// Config to struct binding
+//
+
+#pragma once
+#include "config/options/section.hpp"
+
+namespace neko::config
+{
+  namespace detail
+  {
+    //
+    // Types of struct members a config value can be bound to
+    // Integers and floating point types are converted from
+    // the corresponding value type
+    //
+    template <typename T>
+    concept bindable = val_type<T>;
+
+    //
+    // The value type a member type is read from
+    //
+    template <bindable T>
+    using stored_t = std::conditional_t<std::is_same_v<T, bool>, value::bool_val,
+                     std::conditional_t<std::is_integral_v<T>, value::int_val,
+                     std::conditional_t<std::is_floating_point_v<T>, value::float_val,
+                                        value::str_val>>>;
+
+    //
+    // Cached location of an option relative to the bound section
+    // Holds positions of path segments in their parents' lists
+    // (see section::sections and section::options)
+    //
+    struct field_slot
+    {
+      using pos_type = std::uint32_t;
+      using pos_list = std::array<pos_type, query::maxDepth>;
+
+      pos_list pos{};
+      bool     cached{};
+    };
+
+    //
+    // Follows cached positions and checks that names along the way
+    // match the path
+    // Returns nullptr if the section has a different layout
+    //
+    const option* follow(const section& root, const query& path, const field_slot& slot) noexcept;
+
+    //
+    // Looks the option up by the path and caches its location
+    // Returns nullptr and resets the cache if it doesn't exist
+    //
+    const option* locate(const section& root, const query& path, field_slot& slot) noexcept;
+  }
+
+  //
+  // Describes a struct member bound to a config value
+  // The value is found by a path relative to the bound section
+  // and an index within the option
+  //
+  template <typename Struct, detail::bindable T>
+  class field final
+  {
+  public:
+    using struct_type = Struct;
+    using value_type  = T;
+    using member_type = value_type struct_type::*;
+    using stored_type = detail::stored_t<value_type>;
+    using size_type   = option::size_type;
+
+  public:
+    CLASS_SPECIALS_NODEFAULT(field);
+
+    constexpr field(query path, member_type member, std::type_identity_t<value_type> fallback = {}, size_type index = {}) noexcept :
+      m_path{ path },
+      m_member{ member },
+      m_fallback{ fallback },
+      m_index{ index }
+    { }
+
+  public:
+    //
+    // Path to the option
+    //
+    constexpr const query& path() const noexcept
+    {
+      return m_path;
+    }
+
+    //
+    // Writes a value to the struct
+    // Uses the default if the value is missing or of a different type
+    // Returns false in that case
+    //
+    bool assign(const option* opt, struct_type& dest) const noexcept
+    {
+      if (opt && m_index < opt->size())
+      {
+        const auto val = opt->value_at(m_index);
+        if (auto ptr = val.template try_get<stored_type>())
+        {
+          dest.*m_member = static_cast<value_type>(*ptr);
+          return true;
+        }
+      }
+
+      dest.*m_member = m_fallback;
+      return false;
+    }
+
+  private:
+    query       m_path;
+    member_type m_member{};
+    value_type  m_fallback{};
+    size_type   m_index{};
+  };
+
+  //
+  // Binds a struct to config sections using a list of field descriptors
+  //
+  // Locations of options are cached when a section is bound, the next
+  // section only has its names compared against the cache. Sections of
+  // the same layout, such as a list of unit definitions or a config
+  // reloaded with the same structure, are read without lookups
+  // Nothing is allocated
+  //
+  // See TEST(conf, t_binding)
+  //
+  template <typename Struct, typename ...T>
+  class binding final
+  {
+  public:
+    using struct_type = Struct;
+    using field_list  = std::tuple<field<Struct, T>...>;
+    using size_type   = std::size_t;
+    using slot_list   = std::array<detail::field_slot, sizeof...(T)>;
+
+  public:
+    CLASS_SPECIALS_NODEFAULT(binding);
+
+    constexpr explicit binding(field<Struct, T>... fields) noexcept :
+      m_fields{ fields... }
+    { }
+
+  public:
+    //
+    // Reads all fields from a section into the struct
+    // Missing values and values of wrong types are replaced with defaults
+    // Returns the number of fields read from the section
+    //
+    size_type bind(const section& src, struct_type& dest) noexcept
+    {
+      return bind_all(src, dest, std::index_sequence_for<T...>{});
+    }
+
+  private:
+    template <size_type ...I>
+    size_type bind_all(const section& src, struct_type& dest, std::index_sequence<I...>) noexcept
+    {
+      return (size_type{} + ... + static_cast<size_type>(bind_one<I>(src, dest)));
+    }
+
+    template <size_type I>
+    bool bind_one(const section& src, struct_type& dest) noexcept
+    {
+      auto&& fld  = std::get<I>(m_fields);
+      auto&& slot = m_slots[I];
+      auto opt = slot.cached ? detail::follow(src, fld.path(), slot) : nullptr;
+      if (!opt)
+      {
+        opt = detail::locate(src, fld.path(), slot);
+      }
+
+      return fld.assign(opt, dest);
+    }
+
+  private:
+    //
+    // Field descriptors
+    //
+    field_list m_fields;
+
+    //
+    // Cached option locations, one per field
+    //
+    slot_list  m_slots{};
+  };
+}
@@ -0,0 +1,115 @@
+//
+// Compiled config cache
+//
+
+#pragma once
+#include "platform/file_map.hpp"
+
+namespace neko::config
+{
+  class section;
+
+  //
+  // Binary image of a parsed config
+  // The image is flat and position-independent: records refer to each
+  // other and to the string table by offsets and indices
+  // It is keyed by the hash of the source text and the format version,
+  // so a stale or foreign image is never used
+  //
+  // Loading maps the image once and rebuilds the section tree without
+  // lexing or parsing. String values point into the mapping, so
+  // the image must outlive the tree, unless the strings are copied
+  // into a memory resource on loading
+  //
+  class cfg_image final
+  {
+  public:
+    using name_type = fsys::path;
+    using map_type  = platform::file_map;
+    using hash_type = std::uint64_t;
+    using size_type = std::size_t;
+    using data_type = std::string_view;
+    using res_type  = std::pmr::memory_resource;
+
+    //
+    // Format version. Bump on any layout change
+    //
+    static constexpr std::uint32_t version = 1;
+
+  public:
+    cfg_image(const cfg_image&) = delete;
+    cfg_image& operator=(const cfg_image&) = delete;
+
+    cfg_image(cfg_image&&) noexcept = default;
+    cfg_image& operator=(cfg_image&&) noexcept = default;
+
+    ~cfg_image() noexcept = default;
+
+    cfg_image() noexcept = default;
+
+    //
+    // Checks whether a valid image of the current version is open
+    //
+    explicit operator bool() const noexcept;
+
+  public:
+    //
+    // Computes the hash of config source text
+    //
+    static hash_type hash(data_type data) noexcept;
+
+    //
+    // Returns the name of the image file for a config source file
+    //
+    static name_type name_for(const name_type& source) noexcept;
+
+    //
+    // Writes an image of a section tree
+    // The file is replaced atomically, readers never see a partial image
+    //
+    static bool write(const name_type& fname, const section& root, hash_type srcHash) noexcept;
+
+  public:
+    //
+    // Maps an image file and validates its header
+    //
+    bool open(const name_type& fname) noexcept;
+
+    //
+    // Checks whether the image was compiled from the source with
+    // the specified hash
+    //
+    bool matches(hash_type srcHash) const noexcept;
+
+    //
+    // Rebuilds the section tree under the specified root
+    // The root must be empty
+    // If a resource is specified, the string table is copied into it,
+    // and the tree doesn't refer to the image
+    // Returns false if the image is inconsistent
+    //
+    bool load(section& root, res_type* strings = nullptr) const noexcept;
+
+    //
+    // Unmaps the image
+    //
+    void close() noexcept;
+
+  private:
+    //
+    // Validates the header
+    //
+    bool check() const noexcept;
+
+  private:
+    //
+    // Image file mapping
+    //
+    map_type m_map;
+
+    //
+    // Whether the header is valid
+    //
+    bool     m_valid{};
+  };
+}
@@ -4,6 +4,7 @@
 
 #pragma once
 #include "config/file.hpp"
+#include "config/cache.hpp"
 #include "options/section.hpp"
 
 namespace neko::config
@@ -12,6 +13,20 @@ namespace neko::config
   // Config container
   // Maintains a parsed configuration file and provides
   // an interface to the root section
+  // The whole section tree lives in a monotonic arena owned by the config,
+  // which is sized from the file upfront and released at once on destruction
+  //
+  // Configs can be backed by a compiled image (see cache.hpp). If the
+  // image matches the file, the tree is rebuilt from it without parsing,
+  // otherwise the file is parsed and the image is rewritten
+  //
+  // Large files can be streamed instead (see cfg_file). The tree then
+  // owns copies of its names and strings, and no image is used
+  //
+  // With owned storage, the file is copied rather than mapped, and
+  // strings of a tree loaded from an image are copied into the arena.
+  // Such a tree doesn't refer to anything on disk, so it stays intact
+  // when the file is saved over or the image is replaced
   //
   class cfg final
   {
@@ -19,7 +34,21 @@ namespace neko::config
     using file_type  = cfg_file;
     using file_name  = file_type::name_type;
     using line_type  = file_type::line_type;
+    using size_type  = file_type::size_type;
     using name_type  = section::name_type;
+    using arena_type = std::pmr::monotonic_buffer_resource;
+    using arena_ptr  = std::unique_ptr<arena_type>;
+    using image_type = cfg_image;
+    using storage    = file_type::storage;
+
+    //
+    // Defines whether a compiled image is used
+    //
+    enum class cache_policy : std::uint8_t
+    {
+      none,
+      cached
+    };
 
   public:
     CLASS_SPECIALS_NODEFAULT_NOCOPY(cfg);
@@ -27,7 +56,14 @@ namespace neko::config
     //
     // Constructs configuration from a file
     //
-    explicit cfg(file_name fname) noexcept;
+    explicit cfg(file_name fname, cache_policy cache = cache_policy::none,
+                 storage store = storage::mapped) noexcept;
+
+    //
+    // Constructs configuration from a file streamed in chunks
+    // of the specified size
+    //
+    cfg(file_name fname, size_type chunkSize) noexcept;
 
     //
     // Checks whether the configuration is valid
@@ -44,28 +80,67 @@ namespace neko::config
     //
     const section& operator*() const noexcept;
 
+    //
+    // Checks whether the tree was loaded from a compiled image
+    //
+    bool from_image() const noexcept;
+
   private:
     //
-    // Tries to parse the file
+    // Tries to parse the file and freezes the resulting tree
     // If that fails, discards the file contents and
     // transfers to invalid state
     //
-    void read() noexcept;
+    void read(cache_policy cache) noexcept;
+
+    //
+    // Tries to rebuild the tree from a compiled image of the file
+    //
+    bool load_image(image_type::hash_type srcHash) noexcept;
+
+    //
+    // Writes a compiled image of the parsed tree next to the file
+    //
+    void store_image(image_type::hash_type srcHash) noexcept;
 
     //
     // Parses the file
     //
     bool parse() noexcept;
 
+    //
+    // Creates an arena large enough for a typical tree parsed
+    // from the file
+    //
+    static arena_ptr make_arena(const file_type& file) noexcept;
+
   private:
     //
     // The config file being parsed
     //
-    file_type m_file;
+    file_type  m_file;
+
+    //
+    // Compiled image the tree was loaded from
+    // Strings point into it, so it must outlive the tree
+    // Closed after loading if the file isn't mapped
+    //
+    image_type m_image;
+
+    //
+    // Memory of the section tree
+    // Heap-allocated so that it stays in place when the config is moved
+    //
+    arena_ptr  m_arena;
 
     //
     // The root section
     //
-    section   m_root;
+    section    m_root;
+
+    //
+    // Whether the tree was loaded from an image
+    //
+    bool       m_fromImage{};
   };
 }
\ No newline at end of file
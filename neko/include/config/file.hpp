@@ -3,12 +3,28 @@
 //
 
 #pragma once
+#include "platform/file_map.hpp"
 
 namespace neko::config
 {
   //
   // Configuration file
-  // Handles file I/O and maintains an underlying string buffer
+  // Regular files are mapped into memory read-only and lexed in place,
+  // so string views produced from the file point into the mapped pages
+  // Anything which can't be mapped (pipes, devices, empty files) is
+  // copied into an owned buffer instead
+  // Files can be copied on request as well. Views into a copy stay
+  // valid no matter what happens to the file on disk, while a mapping
+  // sees the file being saved over it, or faults if it shrinks
+  //
+  // Files can also be streamed in fixed-size chunks, so that memory
+  // doesn't grow with the file size. Chunks are cut after the last line
+  // break they contain, the unfinished line is carried over to the next
+  // one, so tokens never span chunks. The buffer holds a chunk plus the
+  // longest line at most
+  // New chunks are pulled by peek once the current one is exhausted.
+  // The last consumed range is moved along, everything before it is
+  // dropped, so only the current token stays valid
   //
   class cfg_file final
   {
@@ -18,8 +34,19 @@ namespace neko::config
     using char_type   = line_type::value_type;
     using in_type     = std::ifstream;
     using out_type    = std::ofstream;
-    using buf_type    = std::string;
-    using iterator    = buf_type::const_iterator;
+    using map_type    = platform::file_map;
+    using buf_type    = std::vector<char_type>;
+    using iterator    = line_type::const_iterator;
+    using size_type   = line_type::size_type;
+
+    //
+    // Defines where file contents are kept
+    //
+    enum class storage : std::uint8_t
+    {
+      mapped, // Mapped into memory where possible
+      owned   // Always copied into an owned buffer
+    };
 
   public:
     CLASS_SPECIALS_NODEFAULT_NOCOPY(cfg_file);
@@ -27,7 +54,12 @@ namespace neko::config
     //
     // Constructs a file from the path
     //
-    explicit cfg_file(name_type fname) noexcept;
+    explicit cfg_file(name_type fname, storage store = storage::mapped) noexcept;
+
+    //
+    // Constructs a file which is streamed in chunks of the specified size
+    //
+    cfg_file(name_type fname, size_type chunkSize) noexcept;
 
     //
     // Checks if there's data to read
@@ -47,6 +79,12 @@ namespace neko::config
     //
     line_type consume(iterator upto) noexcept;
 
+    //
+    // Returns the range returned by the last call to consume
+    // In streaming mode, it might have moved since
+    //
+    line_type last() const noexcept;
+
     //
     // Discards the buffer
     //
@@ -59,6 +97,7 @@ namespace neko::config
 
     //
     // Returns the next non-blank character
+    // In streaming mode, reads the next chunk if the current one is over
     //
     char_type peek() noexcept;
 
@@ -75,14 +114,63 @@ namespace neko::config
     //
     auto end() const noexcept
     {
-      return m_buf.end();
+      return m_data.end();
     }
 
+    //
+    // Checks whether the file contents are mapped rather than copied
+    //
+    bool mapped() const noexcept;
+
+    //
+    // Checks whether the file is streamed in chunks
+    //
+    bool streamed() const noexcept;
+
+    //
+    // Returns the size of the file contents
+    // For streamed files, this is the size of the current chunk
+    //
+    size_type size() const noexcept;
+
+    //
+    // Returns the entire file contents regardless of the read position
+    // For streamed files, this is the current chunk
+    //
+    line_type contents() const noexcept;
+
+    //
+    // Returns the path to the file
+    //
+    const name_type& name() const noexcept;
+
   private:
     //
-    // Reads the entire file into the underlying buffer
+    // Maps the file, falls back to copying if that's impossible
+    // Owned storage always copies
     //
-    void read() noexcept;
+    void read(storage store) noexcept;
+
+    //
+    // Reads the entire file into the owned buffer
+    //
+    void copy() noexcept;
+
+    //
+    // Opens the file for streaming and reads the first chunk
+    //
+    void stream() noexcept;
+
+    //
+    // Reads the next chunk after the current one is exhausted
+    // Returns false if the file is not streamed or is over
+    //
+    bool fetch() noexcept;
+
+    //
+    // Points the data view at the specified memory and rewinds
+    //
+    void attach(const char_type* data, size_type size) noexcept;
 
   private:
     //
@@ -91,13 +179,39 @@ namespace neko::config
     name_type m_name;
 
     //
-    // The underlying buffer
+    // File mapping
+    //
+    map_type  m_map;
+
+    //
+    // Buffer for files which can't be mapped
+    // A vector keeps its storage when moved, so views stay valid
     //
     buf_type  m_buf;
 
+    //
+    // File contents, either mapped or copied
+    //
+    line_type m_data;
+
     //
     // The current buffer read position
     //
     iterator  m_cur;
+
+    //
+    // The range returned by the last call to consume
+    //
+    line_type m_last;
+
+    //
+    // Input stream of a streamed file
+    //
+    in_type   m_stream;
+
+    //
+    // Chunk size of a streamed file, zero otherwise
+    //
+    size_type m_chunk{};
   };
 }
\ No newline at end of file
@@ -0,0 +1,318 @@
+//
+// Perfect hash table for config keys
+//
+
+#pragma once
+
+namespace neko::config
+{
+  namespace keys
+  {
+    using hash_type = std::uint64_t;
+
+    //
+    // FNV-1a hash of a key
+    // Constexpr, so that hashes of known keys can be computed at compile time
+    //
+    constexpr hash_type hash(std::string_view key) noexcept
+    {
+      constexpr auto basis = 0xcbf29ce484222325ull;
+      constexpr auto prime = 0x100000001b3ull;
+
+      auto res = basis;
+      for (auto c : key)
+      {
+        res ^= static_cast<unsigned char>(c);
+        res *= prime;
+      }
+      return res;
+    }
+
+    //
+    // Bit mixer (splitmix64 finaliser)
+    //
+    constexpr hash_type mix(hash_type h) noexcept
+    {
+      h ^= h >> 30;
+      h *= 0xbf58476d1ce4e5b9ull;
+      h ^= h >> 27;
+      h *= 0x94d049bb133111ebull;
+      h ^= h >> 31;
+      return h;
+    }
+
+    //
+    // Reduces a hash to the specified number of bits
+    //
+    constexpr std::size_t reduce(hash_type h, unsigned bits) noexcept
+    {
+      return bits ? static_cast<std::size_t>(h >> (64u - bits)) : 0u;
+    }
+  }
+
+  //
+  // Read-only table of named items built with hash and displace
+  // Keys are split into buckets, each bucket gets a displacement value
+  // which places all of its keys into free slots. Lookup reads the
+  // displacement of the key's bucket and probes exactly one slot
+  // Items must have a name() function
+  //
+  template <typename T>
+  class key_table final
+  {
+  public:
+    using value_type    = T;
+    using pointer       = value_type*;
+    using name_type     = std::string_view;
+    using hash_type     = keys::hash_type;
+    using size_type     = std::size_t;
+    using resource_type = std::pmr::memory_resource;
+    using item_list     = std::span<const pointer>;
+
+    //
+    // Table slot
+    // Keeps the full hash and the key, so that misses never touch items
+    //
+    struct slot
+    {
+      hash_type hash{};
+      name_type name;
+      pointer   item{};
+    };
+
+    using slot_store = std::pmr::vector<slot>;
+    using disp_store = std::pmr::vector<std::uint32_t>;
+
+  private:
+    //
+    // Max displacement value tried for a bucket
+    //
+    static constexpr auto maxDisp = std::uint32_t{ 1u << 16 };
+
+    //
+    // Number of times the table is grown if a layout can't be found
+    //
+    static constexpr auto maxAttempts = 4u;
+
+    //
+    // Average number of keys per bucket
+    //
+    static constexpr auto bucketLoad = size_type{ 4 };
+
+  public:
+    CLASS_SPECIALS_NODEFAULT_NOCOPY(key_table);
+
+    explicit key_table(resource_type& res) noexcept :
+      m_slots{ &res },
+      m_disp{ &res }
+    { }
+
+  public:
+    //
+    // Builds the table over a list of items with unique names
+    // Returns false if that isn't possible, the table stays empty then
+    //
+    bool build(item_list items) noexcept
+    {
+      clear();
+      if (items.empty())
+        return true;
+
+      try
+      {
+        // Scratch data and layouts which don't work out go to a pool of
+        // their own, only the final table is copied to the table's resource
+        std::pmr::unsynchronized_pool_resource scratch;
+        const auto count = items.size();
+        auto slotBits = static_cast<unsigned>(std::bit_width(count + count / 4));
+        const auto bucketBits = static_cast<unsigned>(std::bit_width(count / bucketLoad));
+        for (auto attempt = 0u; attempt < maxAttempts; ++attempt, ++slotBits)
+        {
+          if (try_build(items, slotBits, bucketBits, scratch))
+            return true;
+        }
+      }
+      catch (std::bad_alloc&)
+      { }
+
+      clear();
+      return false;
+    }
+
+    //
+    // Finds an item by name
+    // nullptr if there's no such item
+    //
+    pointer find(name_type name) const noexcept
+    {
+      return find(name, keys::hash(name));
+    }
+
+    //
+    // Finds an item by name with a precomputed hash
+    //
+    pointer find(name_type name, hash_type hash) const noexcept
+    {
+      auto s = slot_for(hash);
+      return (s && s->hash == hash && s->name == name) ? s->item : pointer{};
+    }
+
+    //
+    // Finds an item by an interned name (see names.hpp)
+    // Names of items must be interned as well. Names are compared
+    // by address
+    //
+    pointer find_interned(name_type name, hash_type hash) const noexcept
+    {
+      auto s = slot_for(hash);
+      return (s && s->name.data() == name.data()) ? s->item : pointer{};
+    }
+
+    //
+    // Returns the number of slots in the table
+    //
+    size_type size() const noexcept
+    {
+      return m_slots.size();
+    }
+
+  private:
+    //
+    // Empties the table
+    //
+    void clear() noexcept
+    {
+      m_slots.clear();
+      m_disp.clear();
+      m_slotBits = {};
+      m_bucketBits = {};
+    }
+
+    //
+    // Returns the only slot a key with the specified hash can be in
+    // nullptr if the table is empty
+    //
+    const slot* slot_for(hash_type hash) const noexcept
+    {
+      if (m_slots.empty())
+        return {};
+
+      const auto mixed = keys::mix(hash);
+      const auto disp  = m_disp[keys::reduce(mixed, m_bucketBits)];
+      return &m_slots[slot_index(mixed, disp)];
+    }
+
+    //
+    // Computes the slot index of a mixed hash
+    //
+    size_type slot_index(hash_type mixed, std::uint32_t disp) const noexcept
+    {
+      return keys::reduce(keys::mix(mixed ^ (disp * 0x9e3779b97f4a7c15ull)), m_slotBits);
+    }
+
+    //
+    // Tries to find displacements for the specified table geometry
+    // Builds the layout on the scratch resource and copies it to the
+    // table if it works out
+    //
+    bool try_build(item_list items, unsigned slotBits, unsigned bucketBits, resource_type& scratch)
+    {
+      m_slotBits   = slotBits;
+      m_bucketBits = bucketBits;
+      slot_store slots(size_type{ 1 } << slotBits, slot{}, &scratch);
+      disp_store disp(size_type{ 1 } << bucketBits, 0u, &scratch);
+
+      // Group keys by bucket, the largest buckets are placed first
+      struct key_info
+      {
+        hash_type hash{};
+        hash_type mixed{};
+        size_type bucket{};
+        pointer   item{};
+      };
+
+      std::pmr::vector<key_info> keyList{ &scratch };
+      keyList.reserve(items.size());
+      std::pmr::vector<size_type> bucketSizes(disp.size(), 0u, &scratch);
+      for (auto item : items)
+      {
+        const auto hash  = keys::hash(item->name());
+        const auto mixed = keys::mix(hash);
+        const auto bucket = keys::reduce(mixed, bucketBits);
+        keyList.push_back({ hash, mixed, bucket, item });
+        ++bucketSizes[bucket];
+      }
+
+      std::ranges::sort(keyList, [&bucketSizes](const key_info& l, const key_info& r) noexcept
+        {
+          const auto ls = bucketSizes[l.bucket];
+          const auto rs = bucketSizes[r.bucket];
+          return ls != rs ? ls > rs : l.bucket < r.bucket;
+        });
+
+      for (auto first = keyList.begin(); first != keyList.end();)
+      {
+        const auto last = first + static_cast<std::ptrdiff_t>(bucketSizes[first->bucket]);
+        if (!place(first, last, slots, disp))
+          return false;
+
+        first = last;
+      }
+
+      m_slots.assign(slots.begin(), slots.end());
+      m_disp.assign(disp.begin(), disp.end());
+      return true;
+    }
+
+    //
+    // Places keys of a bucket into free slots
+    //
+    template <typename It>
+    bool place(It first, It last, slot_store& slots, disp_store& disp) const noexcept
+    {
+      for (auto d = std::uint32_t{}; d < maxDisp; ++d)
+      {
+        auto it = first;
+        for (; it != last; ++it)
+        {
+          auto&& s = slots[slot_index(it->mixed, d)];
+          if (s.item)
+            break;
+
+          s = { it->hash, it->item->name(), it->item };
+        }
+
+        if (it == last)
+        {
+          disp[first->bucket] = d;
+          return true;
+        }
+
+        // Undo the partial placement
+        for (auto undo = first; undo != it; ++undo)
+        {
+          slots[slot_index(undo->mixed, d)] = slot{};
+        }
+      }
+
+      return false;
+    }
+
+  private:
+    //
+    // Table slots
+    //
+    slot_store m_slots;
+
+    //
+    // Displacement values of buckets
+    //
+    disp_store m_disp;
+
+    //
+    // Table sizes as powers of two
+    //
+    unsigned m_slotBits{};
+    unsigned m_bucketBits{};
+  };
+}
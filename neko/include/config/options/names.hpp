@@ -0,0 +1,126 @@
+//
+// Interned config names
+//
+
+#pragma once
+#include "config/options/key_table.hpp"
+
+namespace neko::config
+{
+  //
+  // Identifier of an interned name
+  // Ids of equal names are equal, so comparing them is comparing pointers
+  // An empty id refers to no name
+  //
+  class name_id final
+  {
+  public:
+    using name_type = std::string_view;
+    using hash_type = keys::hash_type;
+
+    //
+    // Interned name along with its hash (see keys::hash)
+    //
+    struct entry
+    {
+      name_type str;
+      hash_type hash{};
+    };
+
+  public:
+    CLASS_SPECIALS_ALL(name_id);
+
+    explicit name_id(const entry& e) noexcept :
+      m_entry{ &e }
+    { }
+
+    explicit operator bool() const noexcept
+    {
+      return static_cast<bool>(m_entry);
+    }
+
+    bool operator==(const name_id&) const noexcept = default;
+
+  public:
+    //
+    // Returns the interned name
+    // Empty for an empty id
+    //
+    name_type str() const noexcept
+    {
+      return m_entry ? m_entry->str : name_type{};
+    }
+
+    //
+    // Returns the hash of the name
+    //
+    hash_type hash() const noexcept
+    {
+      return m_entry ? m_entry->hash : hash_type{};
+    }
+
+  private:
+    const entry* m_entry{};
+  };
+
+  //
+  // Process-wide table of section and option names
+  //
+  // Sections intern names of their items, so a name repeated across
+  // sections and files is stored once, and sections key their maps on
+  // ids. Lookups by id compare pointers and never hash or compare strings
+  //
+  // Interned names are never freed and stay valid after the files they
+  // came from are gone. The table is safe to use from multiple threads.
+  // Looking up names which are interned already takes no locks
+  //
+  // See TEST(conf, t_names)
+  //
+  class name_pool final
+  {
+  public:
+    using name_type = name_id::name_type;
+    using hash_type = name_id::hash_type;
+    using size_type = std::size_t;
+
+  public:
+    CLASS_SPECIALS_NONE(name_pool);
+
+  public:
+    //
+    // Interns a name and returns its id
+    // The same name always gets the same id
+    //
+    static name_id intern(name_type name);
+
+    //
+    // Interns a name with a precomputed hash (see keys::hash)
+    //
+    static name_id intern(name_type name, hash_type hash);
+
+    //
+    // Returns the id of a name
+    // The id is empty if the name has never been interned
+    //
+    static name_id find(name_type name) noexcept;
+
+    //
+    // Returns the id of a name with a precomputed hash (see keys::hash)
+    //
+    static name_id find(name_type name, hash_type hash) noexcept;
+
+    //
+    // Returns the number of interned names
+    //
+    static size_type size() noexcept;
+  };
+}
+
+template <>
+struct std::hash<neko::config::name_id>
+{
+  std::size_t operator()(const neko::config::name_id& id) const noexcept
+  {
+    return static_cast<std::size_t>(id.hash());
+  }
+};
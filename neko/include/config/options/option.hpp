@@ -12,14 +12,37 @@ namespace neko::config
   //
   // Config option
   // Can contain one or more values (see value.hpp)
+  // Values are allocated from the memory resource of the owning section
+  //
+  // Long lists of values which are all integers, all floats, or all bools
+  // are packed into typed arrays. Packed integers take a third of the
+  // memory of values, floats and bools even less. They are read as spans
+  // (see as_span and bits), or one by one through value_at and iterators,
+  // which produce values on the fly. Changing a value (see set_value)
+  // unpacks the option
+  //
+  // See TEST(conf, t_packed)
   //
   class option final
   {
+    friend class section;
+
   public:
-    using value_type = value;
-    using name_type  = std::string_view;
-    using val_store  = std::vector<value_type>;
-    using size_type  = val_store::size_type;
+    using value_type    = value;
+    using name_type     = std::string_view;
+    using val_store     = std::pmr::vector<value_type>;
+    using int_store     = std::pmr::vector<value_type::int_val>;
+    using float_store   = std::pmr::vector<value_type::float_val>;
+    using bit_store     = std::pmr::vector<value_type::bool_val>;
+    using store_type    = std::variant<val_store, int_store, float_store, bit_store>;
+    using size_type     = val_store::size_type;
+    using resource_type = std::pmr::memory_resource;
+    using val_span      = std::span<const value_type>;
+
+    //
+    // Minimum number of values for a list to be packed
+    //
+    static constexpr size_type packMin = 16;
 
     //
     // Helper type defining a tuple of matching types
@@ -34,6 +57,53 @@ namespace neko::config
     template <typename T>
     using opt_type = std::optional<T>;
 
+    //
+    // Iterates over values of an option
+    // Yields copies, since packed options have no value objects to refer to
+    //
+    class value_iterator final
+    {
+    public:
+      using iterator_concept  = std::forward_iterator_tag;
+      using iterator_category = std::input_iterator_tag;
+      using value_type        = option::value_type;
+      using difference_type   = std::ptrdiff_t;
+      using reference         = value_type;
+      using pointer           = void;
+
+    public:
+      CLASS_SPECIALS_ALL(value_iterator);
+
+      value_iterator(const option& opt, size_type index) noexcept :
+        m_opt{ &opt },
+        m_index{ index }
+      { }
+
+      value_type operator*() const noexcept
+      {
+        return m_opt->value_at(m_index);
+      }
+
+      value_iterator& operator++() noexcept
+      {
+        ++m_index;
+        return *this;
+      }
+
+      value_iterator operator++(int) noexcept
+      {
+        auto res = *this;
+        ++m_index;
+        return res;
+      }
+
+      bool operator==(const value_iterator&) const noexcept = default;
+
+    private:
+      const option* m_opt{};
+      size_type     m_index{};
+    };
+
   public:
     CLASS_SPECIALS_NODEFAULT_NOCOPY(option);
 
@@ -45,61 +115,85 @@ namespace neko::config
     //
     // Returns an iterator to the values
     //
-    auto begin() const noexcept
+    value_iterator begin() const noexcept
     {
-      return m_values.begin();
+      return { *this, 0 };
     }
 
     //
     // Returns an iterator past the last value
     //
-    auto end() const noexcept
+    value_iterator end() const noexcept
     {
-      return m_values.end();
+      return { *this, size() };
     }
 
     //
-    // Non-const version of begin
+    // Returns a copy of the value at index, same as value_at
+    // No checks performed
     //
-    auto begin() noexcept
+    value_type operator[](size_type index) const noexcept
     {
-      return m_values.begin();
+      return value_at(index);
     }
 
+  public:
     //
-    // Non-const version of end
+    // Adds a value to the collection
+    // A packed option is unpacked first
     //
-    auto end() noexcept
+    void add_value(detail::val_type auto v)
     {
-      return m_values.end();
+      unpack().emplace_back(v);
     }
-    
+
     //
-    // Returns the value at index
-    // No checks performed
+    // Replaces the value at index
+    // A packed option is unpacked first. No checks performed
     //
-    auto& operator[](size_type index) const noexcept
+    void set_value(size_type index, detail::val_type auto v)
     {
-      return m_values[index];
+      unpack()[index] = value_type{ v };
     }
 
     //
-    // Non-const version of []
+    // Adds a list of values to the collection
+    // The list is packed if the option is empty and the values qualify
     //
-    auto& operator[](size_type index) noexcept
-    {
-      return utils::mutate(std::as_const(*this).operator[](index));
-    }
+    void add_values(val_span vals);
 
-  public:
     //
-    // Adds a value to the collection
+    // Returns a copy of the value at index
+    // Works for packed options as well. No checks performed
     //
-    void add_value(detail::val_type auto v)
+    value_type value_at(size_type index) const noexcept;
+
+    //
+    // Checks whether values are packed
+    //
+    bool packed() const noexcept;
+
+    //
+    // Returns packed integers or floats
+    // The span is empty if the option holds anything else
+    //
+    template <typename T>
+      requires (std::is_same_v<T, value_type::int_val> || std::is_same_v<T, value_type::float_val>)
+    std::span<const T> as_span() const noexcept
     {
-      m_values.emplace_back(v);
+      using store = std::pmr::vector<T>;
+      if (auto vals = std::get_if<store>(&m_values))
+        return *vals;
+
+      return {};
     }
 
+    //
+    // Returns packed bools
+    // nullptr if the option holds anything else
+    //
+    const bit_store* bits() const noexcept;
+
     //
     // Returns the option's name
     //
@@ -131,7 +225,8 @@ namespace neko::config
     {
       using std::get;
       using val_type = std::tuple_element_t<I, Tuple>;
-      if (auto valPtr = (*this)[I].template try_get<val_type>())
+      const auto val = value_at(I);
+      if (auto valPtr = val.template try_get<val_type>())
       {
         get<I>(t) = *valPtr;
         return true;
@@ -181,6 +276,13 @@ namespace neko::config
       return to<tuple_type<T...>>();
     }
 
+  private:
+    //
+    // Converts packed values back to value objects
+    // Returns the value collection
+    //
+    val_store& unpack();
+
   private:
     //
     // Owning (parent) config section
@@ -193,9 +295,9 @@ namespace neko::config
     name_type m_name;
 
     //
-    // Value collection
+    // Value collection, either generic or packed
     //
-    val_store m_values;
+    store_type m_values;
   };
 
 
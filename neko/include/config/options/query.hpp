@@ -0,0 +1,140 @@
+//
+// Precompiled config queries
+//
+
+#pragma once
+#include "config/options/key_table.hpp"
+
+namespace neko::config
+{
+  //
+  // Dotted path to a subsection or an option, e.g. "render.shadows.size"
+  // The path is split into segments and each segment is hashed when
+  // the query is constructed. Built from a literal (see _ncq), this
+  // happens at compile time, and lookups don't hash anything
+  //
+  // Segments refer to the original string, which must outlive the query
+  //
+  class query final
+  {
+  public:
+    using name_type = std::string_view;
+    using hash_type = keys::hash_type;
+    using size_type = std::size_t;
+
+    //
+    // A single path segment
+    //
+    struct segment
+    {
+      name_type name;
+      hash_type hash{};
+    };
+
+    //
+    // Maximum number of segments in a path
+    //
+    static constexpr size_type maxDepth = 8;
+
+    using seg_store = std::array<segment, maxDepth>;
+    using seg_span  = std::span<const segment>;
+
+    //
+    // Path separator
+    //
+    static constexpr auto separator = '.';
+
+  public:
+    CLASS_SPECIALS_NODEFAULT(query);
+
+    //
+    // Splits a path into segments and hashes them
+    // The query is invalid if the path is empty, has empty segments,
+    // or has more than maxDepth segments
+    //
+    constexpr explicit query(name_type path) noexcept
+    {
+      while (m_count < maxDepth)
+      {
+        const auto sep = path.find(separator);
+        const auto name = path.substr(0, sep);
+        if (name.empty())
+          break;
+
+        m_segments[m_count++] = { name, keys::hash(name) };
+        if (sep == name_type::npos)
+        {
+          m_valid = true;
+          break;
+        }
+
+        path.remove_prefix(sep + 1);
+      }
+    }
+
+    //
+    // Checks whether the path is well-formed
+    //
+    constexpr explicit operator bool() const noexcept
+    {
+      return m_valid;
+    }
+
+    //
+    // Returns all segments
+    //
+    constexpr seg_span segments() const noexcept
+    {
+      return { m_segments.data(), m_valid ? m_count : 0 };
+    }
+
+    //
+    // Returns all segments but the last one
+    //
+    constexpr seg_span parents() const noexcept
+    {
+      return segments().first(m_valid ? m_count - 1 : 0);
+    }
+
+    //
+    // Returns the last segment
+    // The query must be valid
+    //
+    constexpr const segment& leaf() const noexcept
+    {
+      return m_segments[m_count - 1];
+    }
+
+  private:
+    //
+    // Path segments
+    //
+    seg_store m_segments{};
+
+    //
+    // Number of segments
+    //
+    size_type m_count{};
+
+    //
+    // Whether the path is well-formed
+    //
+    bool      m_valid{};
+  };
+}
+
+namespace neko
+{
+  //
+  // Builds a config query at compile time
+  // Ill-formed paths don't compile
+  //
+  [[nodiscard]] consteval auto operator"" _ncq(const char* s, std::size_t len)
+  {
+    config::query res{ { s, len } };
+    if (!res)
+      throw "Invalid config query path";
+
+    return res;
+  }
+}
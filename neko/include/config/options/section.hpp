@@ -4,29 +4,57 @@
 
 #pragma once
 #include "config/options/option.hpp"
+#include "config/options/names.hpp"
+#include "config/options/query.hpp"
 
 namespace neko::config
 {
   //
   // Config section
   // Can contain an arbitrary number of options and subsections
+  // All memory of a section tree comes from the memory resource of its
+  // root. Parsed configs use an arena owned by their cfg (see conf.hpp)
+  //
+  // Once built, a section can be frozen. Lookups then go through
+  // perfect hash tables (see key_table.hpp) instead of the maps used
+  // for building. Subsections and options are listed in file order
+  //
+  // Nested items can be reached by dotted paths with precompiled
+  // queries (see query.hpp)
+  //
+  // Names of subsections and options are interned (see names.hpp), and
+  // items are keyed on name ids. Looking items up by id compares
+  // pointers instead of strings
   //
   class section final
   {
   public:
-    using name_type  = option::name_type;
-    using value_type = option;
-    using opt_store  = std::unordered_map<name_type, value_type>;
-    using sec_store  = std::unordered_map<name_type, section>;
+    using name_type     = option::name_type;
+    using value_type    = option;
+    using resource_type = option::resource_type;
+    using opt_store     = std::pmr::unordered_map<name_id, value_type>;
+    using sec_store     = std::pmr::unordered_map<name_id, section>;
+    using opt_list      = std::pmr::vector<const value_type*>;
+    using sec_list      = std::pmr::vector<const section*>;
+    using opt_table     = key_table<const value_type>;
+    using sec_table     = key_table<const section>;
+    using opt_span      = std::span<const value_type* const>;
+    using sec_span      = std::span<const section* const>;
+    using hash_type     = keys::hash_type;
 
   public:
     CLASS_SPECIALS_NODEFAULT_NOCOPY(section);
 
     //
-    // Constructs a named section
+    // Constructs a named section using the default memory resource
     //
     explicit section(name_type name) noexcept;
 
+    //
+    // Constructs a named root section allocating from the specified resource
+    //
+    section(name_type name, resource_type& res) noexcept;
+
     //
     // Constructs a named section, which is potentially a
     // subsection of another section
@@ -34,10 +62,16 @@ namespace neko::config
     section(name_type name, section* parent) noexcept;
 
   public:
+    //
+    // Returns the section's name
+    //
+    name_type name() const noexcept;
+
     //
     // Adds a subsection and returns a reference to it
     // If a subsection with the specified name exists, returns the
     // existing one
+    // The section must not be frozen
     //
     section& add_section(name_type name);
 
@@ -52,6 +86,25 @@ namespace neko::config
     //
     const section* get_section(name_type name) const noexcept;
 
+    //
+    // Returns a pointer to a subsection with the specified name
+    // and its precomputed hash (see keys::hash)
+    //
+    const section* get_section(name_type name, hash_type hash) const noexcept;
+
+    //
+    // Returns a pointer to a subsection with the specified interned name
+    // nullptr if one doesn't exist or the id is empty
+    //
+    const section* get_section(name_id id) const noexcept;
+
+    //
+    // Returns a pointer to a nested subsection at the specified path
+    // All segments name sections, one lookup per segment
+    // nullptr if one doesn't exist or the query is invalid
+    //
+    const section* get_section(const query& path) const noexcept;
+
     //
     // Non-const version of get_section
     //
@@ -61,6 +114,7 @@ namespace neko::config
     // Adds an option and returns a reference to it
     // If an option with the specified name exists, returns the
     // existing one
+    // The section must not be frozen
     //
     option& add_option(name_type name);
 
@@ -75,11 +129,53 @@ namespace neko::config
     //
     const option* get_option(name_type name) const noexcept;
 
+    //
+    // Returns a pointer to an option with the specified name
+    // and its precomputed hash (see keys::hash)
+    //
+    const option* get_option(name_type name, hash_type hash) const noexcept;
+
+    //
+    // Returns a pointer to an option with the specified interned name
+    // nullptr if one doesn't exist or the id is empty
+    //
+    const option* get_option(name_id id) const noexcept;
+
+    //
+    // Returns a pointer to an option at the specified path
+    // The last segment names the option, the ones before it
+    // name nested subsections
+    // nullptr if one doesn't exist or the query is invalid
+    //
+    const option* get_option(const query& path) const noexcept;
+
     //
     // Non-const version of get_option
     //
     option* get_option(name_type name) noexcept;
 
+    //
+    // Returns subsections in the order they were added
+    //
+    sec_span sections() const noexcept;
+
+    //
+    // Returns options in the order they were added
+    //
+    opt_span options() const noexcept;
+
+    //
+    // Builds lookup tables for this section and all subsections
+    // Returns false if any of the tables couldn't be built, those
+    // sections keep using slower lookups
+    //
+    bool freeze() noexcept;
+
+    //
+    // Checks whether the section is frozen
+    //
+    bool frozen() const noexcept;
+
     //
     // Returns a pointer to the parent section
     // nullptr if this section is the root one
@@ -96,6 +192,11 @@ namespace neko::config
     //
     bool is_root() const noexcept;
 
+    //
+    // Returns the memory resource this section allocates from
+    //
+    resource_type& resource() const noexcept;
+
   private:
     //
     // Parent section
@@ -117,5 +218,30 @@ namespace neko::config
     // Options associated with this section
     //
     opt_store m_options;
+
+    //
+    // Subsections in the order they were added
+    //
+    sec_list  m_secOrder;
+
+    //
+    // Options in the order they were added
+    //
+    opt_list  m_optOrder;
+
+    //
+    // Subsection lookup table of a frozen section
+    //
+    sec_table m_secTable;
+
+    //
+    // Option lookup table of a frozen section
+    //
+    opt_table m_optTable;
+
+    //
+    // Whether the lookup tables are built
+    //
+    bool      m_frozen{};
   };
 }
\ No newline at end of file
@@ -25,6 +25,11 @@ namespace neko::config
   // - a bool
   // - a string (std::string_view pointing into the file buffer)
   //
+  // Values are 16 bytes, four to a cache line. Scalars are stored inline,
+  // strings as a pointer and a 32-bit length, so they can't be longer
+  // than 4 GiB. Strings are returned as views by value, the rest
+  // by reference
+  //
   class value final
   {
   public:
@@ -32,12 +37,7 @@ namespace neko::config
     using int_val    = std::int64_t;
     using float_val  = float;
     using str_val    = std::string_view;
-    using value_type = std::variant<
-                                     bool_val,
-                                     int_val,
-                                     float_val,
-                                     str_val
-                                   >;
+    using len_type   = std::uint32_t;
 
     template <typename T>
     static constexpr auto type_ok = std::is_same_v<T, bool_val> ||
@@ -45,32 +45,98 @@ namespace neko::config
                                     std::is_same_v<T, float_val> ||
                                     std::is_same_v<T, str_val>;
 
+    //
+    // Type of the stored value
+    //
+    enum class kind : std::uint8_t
+    {
+      boolean,
+      integer,
+      real,
+      string
+    };
+
+    //
+    // Helper type for the result of try_get
+    // A pointer for scalars, an optional for strings
+    //
+    template <typename T>
+    using get_res = std::conditional_t<std::is_same_v<T, str_val>, std::optional<str_val>, const T*>;
+
+  private:
+    //
+    // Returns the kind corresponding to a type
+    //
+    template <typename T> requires (type_ok<T>)
+    static constexpr kind kind_of() noexcept
+    {
+      if constexpr (std::is_same_v<T, bool_val>)
+        return kind::boolean;
+      else if constexpr (std::is_same_v<T, int_val>)
+        return kind::integer;
+      else if constexpr (std::is_same_v<T, float_val>)
+        return kind::real;
+      else
+        return kind::string;
+    }
+
   public:
     CLASS_SPECIALS_NODEFAULT(value);
 
     //
     // Constructs the object from one of allowed types
+    // Integers are stored as int_val, floating point numbers as float_val
     //
-    constexpr value(detail::val_type auto v) noexcept :
-      m_val{ v }
-    { }
+    constexpr value(detail::val_type auto v) noexcept
+    {
+      assign(v);
+    }
 
     //
     // Assigns a new value potentially changing the underlying type
     //
     value& operator=(detail::val_type auto v) noexcept
     {
-      m_val = v;
+      assign(v);
       return *this;
     }
 
+    //
+    // Values are equal if they have the same type and contents
+    //
+    constexpr bool operator==(const value& other) const noexcept
+    {
+      if (m_kind != other.m_kind)
+        return false;
+
+      switch (m_kind)
+      {
+      case kind::boolean:
+        return m_val.b == other.m_val.b;
+      case kind::integer:
+        return m_val.i == other.m_val.i;
+      case kind::real:
+        return m_val.f == other.m_val.f;
+      default:
+        return str_val{ m_val.s, m_len } == str_val{ other.m_val.s, other.m_len };
+      }
+    }
+
+    //
+    // Returns the type of the stored value
+    //
+    constexpr kind type() const noexcept
+    {
+      return m_kind;
+    }
+
     //
     // Checks whether the value is of the specified type
     //
     template <detail::val_type T> requires (type_ok<T>)
-    bool is() const noexcept
+    constexpr bool is() const noexcept
     {
-      return std::holds_alternative<T>(m_val);
+      return m_kind == kind_of<T>();
     }
 
     //
@@ -78,15 +144,23 @@ namespace neko::config
     // No checks performed
     //
     template <detail::val_type T> requires (type_ok<T>)
-    const auto& get() const noexcept
+    constexpr decltype(auto) get() const noexcept
     {
-      return std::get<T>(m_val);
+      if constexpr (std::is_same_v<T, bool_val>)
+        return (m_val.b);
+      else if constexpr (std::is_same_v<T, int_val>)
+        return (m_val.i);
+      else if constexpr (std::is_same_v<T, float_val>)
+        return (m_val.f);
+      else
+        return str_val{ m_val.s, m_len };
     }
 
     //
     // Non-const version of get. Allows reassignment
+    // Strings are only read through the const version
     //
-    template <detail::val_type T> requires (type_ok<T>)
+    template <detail::val_type T> requires (type_ok<T> && !std::is_same_v<T, str_val>)
     auto& get() noexcept
     {
       return utils::mutate(std::as_const(*this).get<T>());
@@ -95,17 +169,25 @@ namespace neko::config
     //
     // Tries to get the value as the specified type
     // Returns a pointer is succeedes, nullptr otherwise
+    // Strings are returned as optionals
     //
     template <detail::val_type T> requires (type_ok<T>)
-    auto try_get() const noexcept
+    constexpr auto try_get() const noexcept -> get_res<T>
     {
-      return std::get_if<T>(&m_val);
+      if (!is<T>())
+        return {};
+
+      if constexpr (std::is_same_v<T, str_val>)
+        return get<T>();
+      else
+        return &get<T>();
     }
 
     //
     // Non-const version of try_get. Allows reassignment
+    // Strings are only read through the const version
     //
-    template <detail::val_type T> requires (type_ok<T>)
+    template <detail::val_type T> requires (type_ok<T> && !std::is_same_v<T, str_val>)
     auto try_get() noexcept
     {
       return utils::mutate(std::as_const(*this).try_get<T>());
@@ -113,8 +195,59 @@ namespace neko::config
 
   private:
     //
-    // A variant holding one of the allowed types
+    // Stores a value of any allowed type
     //
-    value_type m_val;
+    constexpr void assign(detail::val_type auto v) noexcept
+    {
+      using arg_type = decltype(v);
+      if constexpr (std::is_same_v<arg_type, bool_val>)
+      {
+        m_val.b = v;
+        m_kind  = kind::boolean;
+      }
+      else if constexpr (std::is_integral_v<arg_type>)
+      {
+        m_val.i = static_cast<int_val>(v);
+        m_kind  = kind::integer;
+      }
+      else if constexpr (std::is_floating_point_v<arg_type>)
+      {
+        m_val.f = static_cast<float_val>(v);
+        m_kind  = kind::real;
+      }
+      else
+      {
+        NEK_ASSERT(v.size() <= std::numeric_limits<len_type>::max());
+        m_val.s = v.data();
+        m_len   = static_cast<len_type>(v.size());
+        m_kind  = kind::string;
+      }
+    }
+
+  private:
+    //
+    // Inline storage for scalars, or the start of a string
+    //
+    union payload
+    {
+      bool_val    b;
+      int_val     i;
+      float_val   f;
+      const char* s;
+    };
+
+    payload  m_val{};
+
+    //
+    // Length of a string
+    //
+    len_type m_len{};
+
+    //
+    // Type of the stored value
+    //
+    kind     m_kind{};
   };
-}
\ No newline at end of file
+
+  static_assert(sizeof(value) == 16);
+}
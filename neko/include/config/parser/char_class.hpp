@@ -0,0 +1,74 @@
+//
+// Config character classes
+//
+
+#pragma once
+
+namespace neko::config::chars
+{
+  //
+  // Character class bit mask
+  // A character can belong to several classes at once
+  //
+  using mask_type = std::uint8_t;
+
+  inline constexpr mask_type none   = 0x00;
+  inline constexpr mask_type space  = 0x01; // ' ' \t \n \v \f \r
+  inline constexpr mask_type alpha  = 0x02; // [a-z A-Z]
+  inline constexpr mask_type digit  = 0x04; // [0-9]
+  inline constexpr mask_type uscore = 0x08; // _
+  inline constexpr mask_type sign   = 0x10; // + -
+  inline constexpr mask_type punct  = 0x20; // , { }
+
+  //
+  // Characters allowed after the first one in an identifier
+  //
+  inline constexpr mask_type ident = alpha | digit | uscore;
+
+  //
+  // Characters a number can start with
+  //
+  inline constexpr mask_type numStart = sign | digit;
+
+  //
+  // Characters which end identifiers and numbers
+  //
+  inline constexpr mask_type delim = space | punct;
+
+  //
+  // Class table indexed by the character's unsigned value
+  // Doesn't depend on the current locale, everything outside
+  // of ASCII belongs to no class
+  //
+  inline constexpr auto table = []() noexcept
+  {
+    std::array<mask_type, 256> res{};
+    for (auto c : " \t\n\v\f\r"sv)
+      res[static_cast<unsigned char>(c)] |= space;
+
+    for (auto c = 'a'; c <= 'z'; ++c)
+      res[static_cast<unsigned char>(c)] |= alpha;
+
+    for (auto c = 'A'; c <= 'Z'; ++c)
+      res[static_cast<unsigned char>(c)] |= alpha;
+
+    for (auto c = '0'; c <= '9'; ++c)
+      res[static_cast<unsigned char>(c)] |= digit;
+
+    res['_'] |= uscore;
+    res['+'] |= sign;
+    res['-'] |= sign;
+    res[','] |= punct;
+    res['{'] |= punct;
+    res['}'] |= punct;
+    return res;
+  }();
+
+  //
+  // Checks whether the character belongs to any of the classes in the mask
+  //
+  constexpr bool is(char c, mask_type mask) noexcept
+  {
+    return table[static_cast<unsigned char>(c)] & mask;
+  }
+}
@@ -9,6 +9,9 @@ namespace neko::config
 {
   //
   // Lexer for the configuration parser
+  // Characters are classified with lookup tables (see char_class.hpp),
+  // runs of whitespace, identifier characters, digits and string contents
+  // are skipped by block scanners (see scan.hpp)
   //
   class lex final
   {
@@ -17,6 +20,7 @@ namespace neko::config
     using size_type = tok_value::size_type;
     using char_type = tok_value::value_type;
     using file_iter = cfg_file::iterator;
+    using int_type  = std::int64_t;
 
     //
     // Token produced by the lexer
@@ -76,6 +80,11 @@ namespace neko::config
       //
       token_id id{ unknown };
 
+      //
+      // Value of an intNum token, computed while scanning it
+      //
+      int_type intVal{};
+
       using enum token_id;
     };
 
@@ -103,6 +112,8 @@ namespace neko::config
   public:
     //
     // Gets next token
+    // If the file is streamed, the token value is only valid
+    // until the next call
     //
     token next() noexcept;
 
@@ -123,6 +134,8 @@ namespace neko::config
     // Checks if the upcoming token is a numeric value
     // Returns the value type (intNum/floatNum)
     // or unknown if it is not a number
+    // Integer values are accumulated as the digits are scanned,
+    // an integer which overflows is not a number
     //
     tok_id number() noexcept;
 
@@ -170,5 +183,10 @@ namespace neko::config
     // An iterator past the end of the current token
     //
     file_iter m_to;
+
+    //
+    // Value of the current integer token
+    //
+    int_type  m_int{};
   };
 }
\ No newline at end of file
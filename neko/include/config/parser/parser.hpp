@@ -10,6 +10,10 @@ namespace neko::config
 {
   //
   // Parser for configuration files
+  // Names of the tree are interned by sections (see names.hpp)
+  // Strings point into the file, unless it is streamed. Those of
+  // a streamed file are copied to the tree's memory resource, since
+  // the chunks they come from are gone by the end
   //
   class parser final
   {
@@ -25,9 +29,12 @@ namespace neko::config
   public:
     using value_type  = section;
     using option_type = value_type::value_type;
+    using res_type    = value_type::resource_type;
     using value_opt   = std::optional<value_type>;
     using size_type   = lex::size_type;
     using token_type  = lex::token;
+    using name_type   = value_type::name_type;
+    using value_list  = std::vector<option_type::value_type>;
 
   public:
     CLASS_SPECIALS_NONE(parser);
@@ -37,6 +44,12 @@ namespace neko::config
     //
     explicit parser(cfg_file& file) noexcept;
 
+    //
+    // Constructs a parser from a configuration file
+    // The resulting tree is allocated from the specified resource
+    //
+    parser(cfg_file& file, res_type& res) noexcept;
+
     //
     // Checks whether the root section exists
     // This indicates parsing success
@@ -59,9 +72,11 @@ namespace neko::config
     //
     // Value: intNum|floatNum|boolTrue|boolFalse
     // OptionBody: Value , ... , Value
+    // Values are collected in the list and added to the option at once,
+    // which allows long lists to be packed (see option::add_values)
     // Returns the last rejected token type
     //
-    token_type body(option_type& opt) noexcept;
+    token_type body(value_list& vals) noexcept;
 
     //
     // SectionBody: { Body }
@@ -93,6 +108,12 @@ namespace neko::config
     //
     bool parse() noexcept;
 
+    //
+    // Returns the postprocessed token value
+    // Copies it to the resource if the file is streamed
+    //
+    name_type persist(token_type token) noexcept;
+
   private:
     //
     // Lexer used to obtain tokens
@@ -110,5 +131,17 @@ namespace neko::config
     // This is the section whose body is being parsed at the moment
     //
     value_type* m_root{};
+
+    //
+    // Resource for strings of a streamed file
+    // nullptr if they point into the file
+    //
+    res_type* m_strings{};
+
+    //
+    // Values of the option being parsed
+    // Reused between options
+    //
+    value_list m_values;
   };
 }
\ No newline at end of file
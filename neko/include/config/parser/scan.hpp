@@ -0,0 +1,35 @@
+//
+// Config text scanning
+//
+
+#pragma once
+
+namespace neko::config::scan
+{
+  //
+  // Scanners work on raw character ranges and return a pointer
+  // to the first character which ends the scanned run, or last
+  // Where SSE2 is available, 16 characters are checked at a time
+  //
+  using ptr_type = const char*;
+
+  //
+  // Skips whitespace
+  //
+  ptr_type skip_space(ptr_type first, ptr_type last) noexcept;
+
+  //
+  // Skips characters allowed in identifiers
+  //
+  ptr_type skip_ident(ptr_type first, ptr_type last) noexcept;
+
+  //
+  // Skips digits
+  //
+  ptr_type skip_digits(ptr_type first, ptr_type last) noexcept;
+
+  //
+  // Finds a closing quote or the end of the line
+  //
+  ptr_type find_quote(ptr_type first, ptr_type last) noexcept;
+}
@@ -0,0 +1,66 @@
+//
+// Config writer
+//
+
+#pragma once
+#include "config/file.hpp"
+
+namespace neko::config
+{
+  class section;
+
+  //
+  // Serialises section trees to the text format accepted by the parser
+  //
+  // Options go before subsections, both in their original order,
+  // nested items are indented by two spaces per level
+  // Names must be valid identifiers, floats must be finite, and
+  // strings can't contain quotes or line breaks, since the grammar has
+  // no escapes. Trees which break these rules aren't written
+  //
+  // Files are never written in place. Live configs keep their sources
+  // mapped and refer to strings inside them, so the new text
+  // goes to a temporary file which is then renamed over the old one
+  //
+  class cfg_writer final
+  {
+  public:
+    using name_type = cfg_file::name_type;
+    using text_type = std::string;
+    using size_type = text_type::size_type;
+
+  public:
+    CLASS_SPECIALS_NONE(cfg_writer);
+
+  public:
+    //
+    // Serialises the tree and appends the text to the output
+    // Returns false if the tree can't be represented
+    //
+    static bool to_text(const section& root, text_type& out) noexcept;
+
+    //
+    // Replaces the file with the serialised tree
+    //
+    static bool save(const section& root, const name_type& fname) noexcept;
+
+    //
+    // Brings an existing file in line with the tree
+    // Only the value lists of changed options are rewritten, removed items
+    // are cut out along with their lines, new ones are inserted before the
+    // end of their sections. Anything else in the file stays as it is
+    // Nothing is written if the file already matches the tree
+    // Falls back to save if the file is missing or can't be parsed
+    //
+    // See TEST(conf, t_writer)
+    //
+    static bool update(const section& root, const name_type& fname) noexcept;
+
+  private:
+    //
+    // Writes the text to a temporary file, flushes it to the disk
+    // and renames it over the target
+    //
+    static bool replace(const name_type& fname, std::string_view text) noexcept;
+  };
+}
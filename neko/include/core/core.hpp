@@ -64,6 +64,13 @@ namespace neko
     //
     void quit() noexcept;
 
+    //
+    // Applies logging levels from the 'log' section of the root config
+    // Each option in it is a category name with a level name as its value:
+    // .log { input{ 'dbg' } render{ 'warn' } }
+    //
+    void configure_logger() noexcept;
+
     //
     // Polls and dispatches raw input events
     // Returns false if input resulted in a 'quit' signal
@@ -8,6 +8,11 @@
 
 #if _WIN64
   #define NEK_WINDOWS 1
+#elif __linux__
+  #define NEK_LINUX 1
+  #define NEK_POSIX 1
+#elif __unix__ || __APPLE__
+  #define NEK_POSIX 1
 #else
 #endif
 
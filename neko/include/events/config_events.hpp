@@ -0,0 +1,60 @@
+//
+// Config events
+//
+
+#pragma once
+
+namespace neko::evt
+{
+  //
+  // Config reload event
+  // Pushed by the config manager after a config file has been changed
+  // on disk and its new contents have been swapped in
+  //
+  struct config_changed
+  {
+    using key_type     = utils::hashed_string;
+    using name_type    = std::string;
+    using section_list = std::vector<name_type>;
+    using version_type = std::uint64_t;
+
+    CLASS_SPECIALS_NODEFAULT(config_changed);
+
+    config_changed(key_type k, path_type f, section_list secs, version_type ver) noexcept :
+      key{ k },
+      file{ std::move(f) },
+      sections{ std::move(secs) },
+      version{ ver }
+    {}
+
+    //
+    // Checks whether a top-level section has changed
+    //
+    bool changed(std::string_view name) const noexcept
+    {
+      return std::find(sections.begin(), sections.end(), name) != sections.end();
+    }
+
+    //
+    // Name the config is registered with
+    //
+    key_type     key;
+
+    //
+    // Path to the config file
+    //
+    path_type    file;
+
+    //
+    // Top-level sections which were added, removed, or modified
+    // Options of the root section are reported as the root's name
+    //
+    section_list sections;
+
+    //
+    // Version the config has been published with
+    // (see conf_manager::acquire)
+    //
+    version_type version{};
+  };
+}
@@ -0,0 +1,171 @@
+//
+// Fixed-size log buffers
+//
+
+#pragma once
+
+namespace neko::logging
+{
+  //
+  // Output iterator writing into a fixed buffer
+  // Characters past the end are dropped
+  //
+  struct bounded_out
+  {
+    using iterator_category = std::output_iterator_tag;
+    using value_type        = void;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = void;
+    using reference         = void;
+
+    bounded_out& operator*() noexcept
+    {
+      return *this;
+    }
+    bounded_out& operator++() noexcept
+    {
+      return *this;
+    }
+    // Writes advance the position, so *out++ = c has to write through
+    // this object rather than a copy
+    bounded_out& operator++(int) noexcept
+    {
+      return *this;
+    }
+    bounded_out& operator=(char c) noexcept
+    {
+      if (cur != last)
+      {
+        *cur++ = c;
+      }
+      return *this;
+    }
+
+    //
+    // Returns the number of characters which still fit
+    //
+    std::size_t room() const noexcept
+    {
+      return static_cast<std::size_t>(last - cur);
+    }
+
+    //
+    // Drops everything written from now on
+    //
+    void stop() noexcept
+    {
+      last = cur;
+    }
+
+    char* cur{};
+    char* last{};
+  };
+
+  //
+  // A character buffer of a fixed capacity
+  // Never allocates, anything which doesn't fit is dropped
+  //
+  template <std::size_t N>
+  class fixed_buffer final
+  {
+  public:
+    using size_type  = std::size_t;
+    using value_type = char;
+    using data_type  = std::array<value_type, N>;
+
+    static constexpr auto capacity = N;
+
+  public:
+    CLASS_SPECIALS_NONE_CUSTOM(fixed_buffer);
+
+    fixed_buffer() noexcept = default;
+
+  public:
+    //
+    // Returns the buffer contents
+    //
+    std::string_view view() const noexcept
+    {
+      return { m_data.data(), m_size };
+    }
+
+    //
+    // Returns the number of characters in the buffer
+    //
+    size_type size() const noexcept
+    {
+      return m_size;
+    }
+
+    //
+    // Returns the number of characters which can still be added
+    //
+    size_type space() const noexcept
+    {
+      return capacity - m_size;
+    }
+
+    //
+    // Checks whether the buffer is full
+    //
+    bool full() const noexcept
+    {
+      return m_size == capacity;
+    }
+
+    //
+    // Empties the buffer
+    //
+    void clear() noexcept
+    {
+      m_size = {};
+    }
+
+    //
+    // Returns an output iterator writing at the end of the buffer
+    // Call commit with the resulting iterator to account for the written data
+    //
+    bounded_out out() noexcept
+    {
+      return { m_data.data() + m_size, m_data.data() + capacity };
+    }
+
+    //
+    // Updates the size after writing through an iterator returned by out
+    //
+    void commit(const bounded_out& it) noexcept
+    {
+      NEK_ASSERT(it.cur >= m_data.data() && it.cur <= m_data.data() + capacity);
+      m_size = static_cast<size_type>(it.cur - m_data.data());
+    }
+
+    //
+    // Appends a string
+    // Returns false if it was truncated
+    //
+    bool append(std::string_view str) noexcept
+    {
+      const auto count = std::min(str.size(), space());
+      std::copy_n(str.data(), count, m_data.data() + m_size);
+      m_size += count;
+      return count == str.size();
+    }
+
+    //
+    // Terminates the contents with the specified character
+    // Overwrites the last one if the buffer is full
+    //
+    void terminate(value_type c) noexcept
+    {
+      if (full())
+      {
+        --m_size;
+      }
+      m_data[m_size++] = c;
+    }
+
+  private:
+    data_type m_data;
+    size_type m_size{};
+  };
+}
@@ -0,0 +1,178 @@
+//
+// Log levels and categories
+//
+
+#pragma once
+
+//
+// Compile-time logging levels
+// Messages above the level of their category are removed entirely
+// 0 - off, 1 - errors, 2 - warnings, 3 - notes, 4 - traces
+// Override these with compiler definitions to keep, for example,
+// input traces in release builds: -DNEK_LOG_LEVEL_INPUT=4
+//
+#ifndef NEK_LOG_LEVEL_DEFAULT
+  #ifndef NDEBUG
+    #define NEK_LOG_LEVEL_DEFAULT 4
+  #else
+    #define NEK_LOG_LEVEL_DEFAULT 3
+  #endif
+#endif
+
+#ifndef NEK_LOG_LEVEL_CORE
+  #define NEK_LOG_LEVEL_CORE NEK_LOG_LEVEL_DEFAULT
+#endif
+#ifndef NEK_LOG_LEVEL_CONFIG
+  #define NEK_LOG_LEVEL_CONFIG NEK_LOG_LEVEL_DEFAULT
+#endif
+#ifndef NEK_LOG_LEVEL_INPUT
+  #define NEK_LOG_LEVEL_INPUT NEK_LOG_LEVEL_DEFAULT
+#endif
+#ifndef NEK_LOG_LEVEL_RENDER
+  #define NEK_LOG_LEVEL_RENDER NEK_LOG_LEVEL_DEFAULT
+#endif
+#ifndef NEK_LOG_LEVEL_PLATFORM
+  #define NEK_LOG_LEVEL_PLATFORM NEK_LOG_LEVEL_DEFAULT
+#endif
+#ifndef NEK_LOG_LEVEL_GAME
+  #define NEK_LOG_LEVEL_GAME NEK_LOG_LEVEL_DEFAULT
+#endif
+
+namespace neko::logging
+{
+  //
+  // Logging level
+  //
+  enum class level : std::uint8_t
+  {
+    off,
+    err,
+    warn,
+    msg,
+    dbg
+  };
+
+  //
+  // Log category
+  // Each one has its own compile-time and runtime level
+  //
+  enum class category : std::uint8_t
+  {
+    core,
+    config,
+    input,
+    render,
+    platform,
+    game
+  };
+
+  namespace detail
+  {
+    inline constexpr std::array categoryNames {
+      "core"sv,
+      "config"sv,
+      "input"sv,
+      "render"sv,
+      "platform"sv,
+      "game"sv
+    };
+
+    inline constexpr std::array levelNames {
+      "off"sv,
+      "err"sv,
+      "warn"sv,
+      "msg"sv,
+      "dbg"sv
+    };
+
+    inline constexpr std::array compiledLevels {
+      static_cast<level>(NEK_LOG_LEVEL_CORE),
+      static_cast<level>(NEK_LOG_LEVEL_CONFIG),
+      static_cast<level>(NEK_LOG_LEVEL_INPUT),
+      static_cast<level>(NEK_LOG_LEVEL_RENDER),
+      static_cast<level>(NEK_LOG_LEVEL_PLATFORM),
+      static_cast<level>(NEK_LOG_LEVEL_GAME)
+    };
+
+    static_assert(categoryNames.size() == compiledLevels.size());
+  }
+
+  //
+  // Total number of categories
+  //
+  inline constexpr auto categoryCount = detail::categoryNames.size();
+
+  //
+  // Converts a category to an array index
+  //
+  constexpr auto to_index(category cat) noexcept
+  {
+    return static_cast<std::size_t>(cat);
+  }
+
+  //
+  // Checks whether messages of the specified category and level
+  // are compiled in
+  //
+  template <category Cat, level Lvl>
+  inline constexpr bool compiled_in = Lvl != level::off && Lvl <= detail::compiledLevels[to_index(Cat)];
+
+  //
+  // Returns the name of a category
+  //
+  constexpr auto to_string(category cat) noexcept
+  {
+    return detail::categoryNames[to_index(cat)];
+  }
+
+  //
+  // Returns the name of a level
+  //
+  constexpr auto to_string(level lvl) noexcept
+  {
+    return detail::levelNames[static_cast<std::size_t>(lvl)];
+  }
+
+  //
+  // Finds a category by name
+  //
+  constexpr std::optional<category> to_category(std::string_view name) noexcept
+  {
+    for (auto idx = 0ull; idx < categoryCount; ++idx)
+    {
+      if (detail::categoryNames[idx] == name)
+        return static_cast<category>(idx);
+    }
+    return {};
+  }
+
+  //
+  // Finds a level by name
+  //
+  constexpr std::optional<level> to_level(std::string_view name) noexcept
+  {
+    for (auto idx = 0ull; idx < detail::levelNames.size(); ++idx)
+    {
+      if (detail::levelNames[idx] == name)
+        return static_cast<level>(idx);
+    }
+    return {};
+  }
+}
+
+//
+// Posts a message of the specified category and level
+// Removed entirely (arguments aren't evaluated) if the compile-time
+// level of the category is lower
+// Example: NEK_LOG(input, dbg, "Key {} pressed", key);
+//
+#define NEK_LOG(cat, lvl, ...) do {\
+  if constexpr (neko::logging::compiled_in<neko::logging::category::cat, neko::logging::level::lvl>) {\
+    neko::logger::log<neko::logging::category::cat, neko::logging::level::lvl>(__VA_ARGS__);\
+  }\
+} while (false)
+
+//
+// Posts a trace message to the specified category
+//
+#define NEK_TRACE_IN(cat, ...) NEK_LOG(cat, dbg, __VA_ARGS__)
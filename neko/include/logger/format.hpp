@@ -0,0 +1,120 @@
+//
+// Log format string
+//
+
+#pragma once
+
+namespace neko::logging
+{
+  //
+  // Log output format
+  //
+  enum class output : std::uint8_t
+  {
+    text, // =={time}== [level]: message | key=value, ...
+    json  // One JSON object per line
+  };
+
+  //
+  // Format string of a log message
+  // Implicitly constructed from anything convertible to a string view
+  // and remembers the call site it was created at
+  // This allows distinguishing messages by their origin without
+  // changing the signatures of logging functions
+  //
+  class fmt_string final
+  {
+  public:
+    using value_type = std::string_view;
+    using loc_type   = std::source_location;
+
+  public:
+    CLASS_SPECIALS_NODEFAULT(fmt_string);
+
+    template <typename Str> requires (std::is_convertible_v<const Str&, value_type>)
+    fmt_string(const Str& str, loc_type loc = loc_type::current()) noexcept :
+      m_str{ str },
+      m_loc{ loc }
+    { }
+
+  public:
+    //
+    // Returns the format string
+    //
+    value_type str() const noexcept
+    {
+      return m_str;
+    }
+
+    //
+    // Returns the call site location
+    //
+    const loc_type& location() const noexcept
+    {
+      return m_loc;
+    }
+
+  private:
+    //
+    // The format string
+    //
+    value_type m_str;
+
+    //
+    // Call site
+    //
+    loc_type   m_loc;
+  };
+}
+
+namespace neko::logging
+{
+  //
+  // A named value attached to a log message
+  // In text output, fields are appended to the message as key=value
+  // In JSON output, they are written as typed members of the 'fields' object
+  // Fields only live as long as the logging call, so they keep a reference
+  //
+  template <typename T>
+  struct field
+  {
+    using value_type = T;
+
+    std::string_view key;
+    const value_type& value;
+  };
+
+  //
+  // Checks whether the type is a field
+  //
+  template <typename T>
+  inline constexpr bool is_field = false;
+
+  template <typename T>
+  inline constexpr bool is_field<field<T>> = true;
+
+  //
+  // Creates a field
+  // Example: logger::note("Level loaded", kv("units", count), kv("name", name));
+  //
+  template <typename T>
+  constexpr auto kv(std::string_view key, const T& value) noexcept
+  {
+    return field<T>{ key, value };
+  }
+}
+
+template <typename T>
+struct std::formatter<neko::logging::field<T>, char>
+{
+  constexpr auto parse(std::format_parse_context& ctx)
+  {
+    return ctx.begin();
+  }
+
+  template <typename Ctx>
+  auto format(const neko::logging::field<T>& f, Ctx& ctx) const
+  {
+    return std::format_to(ctx.out(), "{}={}", f.key, f.value);
+  }
+};
@@ -0,0 +1,253 @@
+//
+// JSON log output helpers
+//
+
+#pragma once
+#include "logger/format.hpp"
+#include "logger/buffer.hpp"
+
+namespace neko::logging::json
+{
+  //
+  // Writes a string as is
+  //
+  template <typename Out>
+  Out raw(Out out, std::string_view str) noexcept
+  {
+    return std::copy(str.begin(), str.end(), out);
+  }
+
+  //
+  // Writes an escape sequence as a whole
+  // A bounded output which can't take all of it is stopped, so strings
+  // cut short never end in a partial escape
+  //
+  template <typename Out>
+  Out sequence(Out out, std::string_view seq) noexcept
+  {
+    if constexpr (std::is_same_v<Out, bounded_out>)
+    {
+      if (out.room() < seq.size())
+      {
+        out.stop();
+        return out;
+      }
+    }
+
+    return raw(out, seq);
+  }
+
+  //
+  // Writes a character escaping it if required
+  //
+  template <typename Out>
+  Out put(Out out, char c) noexcept
+  {
+    switch (c)
+    {
+    case '"':
+      return sequence(out, "\\\""sv);
+
+    case '\\':
+      return sequence(out, "\\\\"sv);
+
+    case '\n':
+      return sequence(out, "\\n"sv);
+
+    case '\r':
+      return sequence(out, "\\r"sv);
+
+    case '\t':
+      return sequence(out, "\\t"sv);
+
+    default:
+      break;
+    }
+
+    if (const auto code = static_cast<unsigned char>(c); code < 0x20)
+    {
+      constexpr auto hex = "0123456789abcdef"sv;
+      const std::array<char, 6> seq{ '\\', 'u', '0', '0', hex[code >> 4], hex[code & 0xF] };
+      return sequence(out, { seq.data(), seq.size() });
+    }
+
+    *out++ = c;
+    return out;
+  }
+
+  //
+  // Writes a string escaping characters where required
+  //
+  template <typename Out>
+  Out escape(Out out, std::string_view str) noexcept
+  {
+    for (auto c : str)
+    {
+      out = put(out, c);
+    }
+    return out;
+  }
+
+  //
+  // Writes a string which might be cut short to the space left before
+  // a limit, followed by the rest of the output
+  // The string ends at a whole character or escape
+  //
+  template <typename Fn>
+  bounded_out limited(bounded_out out, std::size_t reserve, Fn&& write) noexcept(noexcept(write(out)))
+  {
+    const auto last = out.last;
+    const auto start = out.cur;
+    out.last = out.room() > reserve ? last - reserve : out.cur;
+    out = write(out);
+    if (out.cur == out.last)
+    {
+      // Drop an incomplete UTF-8 sequence
+      auto lead = out.cur;
+      auto cont = 0;
+      while (lead != start && cont < 4 && (static_cast<unsigned char>(lead[-1]) & 0xC0) == 0x80)
+      {
+        --lead;
+        ++cont;
+      }
+
+      if (lead != start)
+      {
+        const auto code = static_cast<unsigned char>(lead[-1]);
+        const auto length = code >= 0xF0 ? 4 : code >= 0xE0 ? 3 : code >= 0xC0 ? 2 : 1;
+        if (length > 1 && cont + 1 < length)
+        {
+          out.cur = lead - 1;
+        }
+      }
+    }
+
+    out.last = last;
+    return out;
+  }
+
+  //
+  // Output iterator adaptor which escapes everything written through it
+  // Allows formatting messages straight into JSON strings
+  //
+  template <typename Out>
+  class escaper
+  {
+  public:
+    using iterator_category = std::output_iterator_tag;
+    using value_type        = void;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = void;
+    using reference         = void;
+
+  public:
+    CLASS_SPECIALS_ALL(escaper);
+
+    explicit escaper(Out out) noexcept :
+      m_out{ out }
+    { }
+
+    escaper& operator*() noexcept
+    {
+      return *this;
+    }
+    escaper& operator++() noexcept
+    {
+      return *this;
+    }
+    escaper& operator++(int) noexcept
+    {
+      return *this;
+    }
+    escaper& operator=(char c) noexcept
+    {
+      m_out = put(m_out, c);
+      return *this;
+    }
+
+    //
+    // Returns the underlying iterator
+    //
+    Out base() const noexcept
+    {
+      return m_out;
+    }
+
+  private:
+    Out m_out{};
+  };
+
+  //
+  // Writes a typed JSON value
+  // Characters are written as one-character strings
+  //
+  template <typename Out, typename T>
+  Out value(Out out, const T& val)
+  {
+    using type = std::remove_cvref_t<T>;
+    if constexpr (std::is_same_v<type, bool>)
+    {
+      return raw(out, val ? "true"sv : "false"sv);
+    }
+    else if constexpr (std::is_convertible_v<const T&, std::string_view>)
+    {
+      *out++ = '"';
+      out = escape(out, std::string_view{ val });
+      *out++ = '"';
+      return out;
+    }
+    else if constexpr (std::is_same_v<type, char>)
+    {
+      *out++ = '"';
+      out = put(out, val);
+      *out++ = '"';
+      return out;
+    }
+    else if constexpr (std::is_integral_v<type>)
+    {
+      return std::format_to(out, "{}", val);
+    }
+    else if constexpr (std::is_floating_point_v<type>)
+    {
+      if (!std::isfinite(val))
+        return raw(out, "null"sv);
+
+      return std::format_to(out, "{}", val);
+    }
+    else
+    {
+      *out++ = '"';
+      out = std::format_to(escaper<Out>{ out }, "{}", val).base();
+      *out++ = '"';
+      return out;
+    }
+  }
+
+  //
+  // Writes a field as a member of an object
+  // Arguments which are not fields are skipped
+  //
+  template <typename Out, typename T>
+  Out member(Out out, bool& first, const T& arg)
+  {
+    if constexpr (is_field<std::remove_cvref_t<T>>)
+    {
+      if (!first)
+      {
+        *out++ = ',';
+      }
+      first = false;
+
+      *out++ = '"';
+      out = escape(out, arg.key);
+      out = raw(out, "\":"sv);
+      return value(out, arg.value);
+    }
+    else
+    {
+      utils::unused(first);
+      utils::unused(arg);
+      return out;
+    }
+  }
+}
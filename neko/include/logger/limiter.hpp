@@ -0,0 +1,246 @@
+//
+// Log rate limiter
+//
+
+#pragma once
+#include "logger/format.hpp"
+
+namespace neko::logging
+{
+  namespace detail
+  {
+    using hash_type = std::size_t;
+
+    inline void hash_combine(hash_type& seed, hash_type val) noexcept
+    {
+      seed ^= val + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2);
+    }
+
+    //
+    // Mixes a formatting argument into the seed
+    // Returns false if the argument type can't be hashed cheaply
+    //
+    template <typename T>
+    bool hash_arg(hash_type& seed, const T& arg) noexcept
+    {
+      using type = std::remove_cvref_t<T>;
+      if constexpr (std::is_convertible_v<const T&, std::string_view>)
+      {
+        hash_combine(seed, std::hash<std::string_view>{}(std::string_view{ arg }));
+        return true;
+      }
+      else if constexpr (std::is_enum_v<type>)
+      {
+        hash_combine(seed, static_cast<hash_type>(arg));
+        return true;
+      }
+      else if constexpr (std::is_arithmetic_v<type> || std::is_pointer_v<type>)
+      {
+        hash_combine(seed, std::hash<type>{}(arg));
+        return true;
+      }
+      else if constexpr (is_field<type>)
+      {
+        hash_combine(seed, std::hash<std::string_view>{}(arg.key));
+        return hash_arg(seed, arg.value);
+      }
+      else
+      {
+        utils::unused(arg);
+        return false;
+      }
+    }
+  }
+
+  //
+  // Computes a fingerprint of an unformatted message
+  // Two messages with equal fingerprints produce identical output
+  // Returns an empty optional if some argument can't be fingerprinted
+  //
+  template <typename ...Args>
+  std::optional<detail::hash_type> fingerprint(std::string_view fmt, const Args& ...args) noexcept
+  {
+    auto seed = std::hash<std::string_view>{}(fmt);
+    if ((detail::hash_arg(seed, args) && ...))
+      return seed;
+
+    return {};
+  }
+
+  //
+  // Rate limiter and duplicate filter for log messages
+  // Messages are identified by their call site. Each site can post a
+  // limited number of messages within an interval, the rest are dropped
+  // Consecutive identical messages are collapsed into a single one followed
+  // by a 'repeated K times' notice
+  // All checks are done before messages are formatted
+  //
+  class limiter final
+  {
+  public:
+    using clock_type = std::chrono::steady_clock;
+    using time_point = clock_type::time_point;
+    using duration   = clock_type::duration;
+    using loc_type   = std::source_location;
+    using size_type  = std::size_t;
+    using hash_type  = detail::hash_type;
+    using hash_opt   = std::optional<hash_type>;
+    using tag_type   = std::uint8_t;
+
+    //
+    // Result of a check
+    //
+    struct verdict
+    {
+      //
+      // Checks whether the message should be posted
+      //
+      explicit operator bool() const noexcept
+      {
+        return pass;
+      }
+
+      //
+      // Number of times the previous message was repeated
+      // before this one arrived
+      //
+      size_type repeated{};
+
+      //
+      // Tag of the previous message
+      //
+      tag_type repeatTag{};
+
+      //
+      // Number of messages dropped from this call site during
+      // the previous interval
+      //
+      size_type suppressed{};
+
+      //
+      // Whether the message should be posted
+      //
+      bool pass{};
+    };
+
+    //
+    // Number of tracked call sites
+    // Sites which don't fit into the table are never limited
+    //
+    static constexpr size_type siteCount = 256ull;
+
+    //
+    // Maximum probe length in the site table
+    //
+    static constexpr size_type maxProbe  = 8ull;
+
+  private:
+    //
+    // Call site state
+    //
+    struct site
+    {
+      const char* file{};
+      std::uint_least32_t line{};
+      std::uint_least32_t column{};
+      time_point start{};
+      size_type  count{};
+      size_type  suppressed{};
+    };
+
+    //
+    // The last posted message
+    //
+    struct last_msg
+    {
+      const char* file{};
+      std::uint_least32_t line{};
+      std::uint_least32_t column{};
+      hash_type  hash{};
+      size_type  repeats{};
+      tag_type   tag{};
+      bool       valid{};
+    };
+
+    using site_table = std::array<site, siteCount>;
+
+  public:
+    CLASS_SPECIALS_NONE_CUSTOM(limiter);
+
+    limiter() noexcept;
+
+  public:
+    //
+    // Checks whether a message from the specified site can be posted
+    // The fingerprint is used to detect repetitions,
+    // an empty one means the message is never collapsed
+    // The tag is an arbitrary value stored along with the message
+    // Unlimited messages bypass rate limiting, but are still collapsed
+    //
+    verdict check(const loc_type& loc, hash_opt fp, tag_type tag, bool limited) noexcept;
+
+    //
+    // Resets the repetition counter and returns its previous value
+    //
+    size_type flush_repeats() noexcept;
+
+    //
+    // Returns the tag of the last posted message
+    //
+    tag_type last_tag() const noexcept;
+
+    //
+    // Sets the number of messages a single site can post within an interval
+    // Zero count disables rate limiting
+    //
+    void set_rate(size_type count, duration interval) noexcept;
+
+    //
+    // Enables or disables collapsing of repeated messages
+    //
+    void set_collapse(bool enable) noexcept;
+
+  private:
+    //
+    // Finds or creates the state of a call site
+    // Returns nullptr if the table is full
+    //
+    site* find_site(const loc_type& loc) noexcept;
+
+    //
+    // Applies the rate limit to a call site
+    //
+    bool admit(site& s, time_point now, verdict& res) noexcept;
+
+    //
+    // Checks whether the message repeats the last one
+    //
+    bool repeats(const loc_type& loc, hash_opt fp) const noexcept;
+
+  private:
+    //
+    // Call site states
+    //
+    site_table m_sites{};
+
+    //
+    // Last posted message
+    //
+    last_msg   m_last{};
+
+    //
+    // Rate limiting interval
+    //
+    duration   m_interval{ std::chrono::seconds{ 1 } };
+
+    //
+    // Number of messages per interval
+    //
+    size_type  m_rate{ 100 };
+
+    //
+    // Whether to collapse repeated messages
+    //
+    bool       m_collapse{ true };
+  };
+}
@@ -0,0 +1,133 @@
+//
+// Log file
+//
+
+#pragma once
+#include "platform/file_map.hpp"
+
+namespace neko::logging
+{
+  //
+  // Memory-mapped log file
+  // Space is preallocated in fixed-size segments and messages are
+  // copied straight into the mapping
+  // When the file reaches its size limit, it is rotated:
+  // engine.log -> engine.1.log -> engine.2.log ...
+  // Only a limited number of old files is kept
+  //
+  class log_file final
+  {
+  public:
+    using name_type  = fsys::path;
+    using size_type  = std::size_t;
+    using value_type = std::string_view;
+    using map_type   = platform::file_map;
+
+    //
+    // Default size of a preallocated segment
+    //
+    static constexpr size_type defaultSegment  = 1024ull * 1024ull;
+
+    //
+    // Default size limit of a single file
+    //
+    static constexpr size_type defaultMaxSize  = 16ull * defaultSegment;
+
+    //
+    // Default number of rotated files to keep
+    //
+    static constexpr size_type defaultMaxFiles = 4ull;
+
+  public:
+    CLASS_SPECIALS_NONE_CUSTOM(log_file);
+
+    ~log_file() noexcept;
+
+    log_file() noexcept;
+
+    //
+    // Checks whether the file is open
+    //
+    explicit operator bool() const noexcept;
+
+  public:
+    //
+    // Opens the file for writing
+    // Any previously opened file is closed
+    //
+    bool open(name_type fname) noexcept;
+
+    //
+    // Truncates the file to the written size and closes it
+    //
+    void close() noexcept;
+
+    //
+    // Copies data to the file
+    // Grows or rotates the file if necessary
+    //
+    void write(value_type data) noexcept;
+
+    //
+    // Sets the maximum size of a single file and the number of
+    // rotated files to keep
+    // Zero maxFiles means the file is restarted from scratch
+    // once it reaches its size limit
+    //
+    void set_rotation(size_type maxSize, size_type maxFiles) noexcept;
+
+    //
+    // Returns the number of bytes written to the current file
+    //
+    size_type size() const noexcept;
+
+  private:
+    //
+    // Makes sure the mapping has room for the specified number of bytes
+    //
+    bool reserve(size_type count) noexcept;
+
+    //
+    // Closes the current file, shifts the old ones,
+    // and starts a new one
+    //
+    bool rotate() noexcept;
+
+    //
+    // Builds the name of a rotated file
+    // The current one has the index of 0
+    //
+    name_type rotated_name(size_type idx) const noexcept;
+
+  private:
+    //
+    // The underlying mapping
+    //
+    map_type  m_map;
+
+    //
+    // Path to the current file
+    //
+    name_type m_name;
+
+    //
+    // Write position
+    //
+    size_type m_pos{};
+
+    //
+    // Size of a preallocated segment
+    //
+    size_type m_segment{ defaultSegment };
+
+    //
+    // Size limit of a single file
+    //
+    size_type m_maxSize{ defaultMaxSize };
+
+    //
+    // Number of rotated files to keep
+    //
+    size_type m_maxFiles{ defaultMaxFiles };
+  };
+}
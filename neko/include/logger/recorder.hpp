@@ -0,0 +1,275 @@
+//
+// Log flight recorder
+//
+
+#pragma once
+#include "platform/raw_file.hpp"
+
+namespace neko::logging
+{
+  //
+  // Flight recorder
+  // Keeps a fixed-size ring of the most recent messages of all levels
+  // Messages are not formatted when recorded. Instead, the format string
+  // and the arguments are copied into the ring, and formatting is done
+  // only when the ring is dumped (on termination or a fatal signal)
+  //
+  // Dumping the ring doesn't allocate, lock or go through std::format,
+  // so it is safe to do from a signal handler. The crash file is opened
+  // and the time zone offset is looked up in advance, when the recorder
+  // is armed. Replacement fields in format strings are filled with
+  // arguments in their default form, format specs are ignored
+  //
+  class recorder final
+  {
+  public:
+    using clock_type = std::chrono::system_clock;
+    using time_point = clock_type::time_point;
+    using size_type  = std::size_t;
+    using str_type   = std::string_view;
+    using file_name  = fsys::path;
+    using len_type   = std::uint16_t;
+    using off_type   = std::chrono::seconds;
+
+    //
+    // Number of messages kept
+    //
+    static constexpr size_type capacity = 1024ull;
+
+    //
+    // Maximum number of arguments recorded per message
+    //
+    static constexpr size_type maxArgs  = 8ull;
+
+    //
+    // Storage for the format string and string arguments
+    //
+    static constexpr size_type textSize = 192ull;
+
+    //
+    // Recorded argument
+    //
+    struct arg
+    {
+      enum class kind : std::uint8_t
+      {
+        none,
+        boolean,
+        character,
+        sint,
+        uint,
+        flt,
+        dbl,
+        ptr,
+        str
+      };
+
+      using enum kind;
+
+      union
+      {
+        bool          b;
+        char          c;
+        std::int64_t  i;
+        std::uint64_t u;
+        float         f;
+        double        d;
+        const void*   p;
+      };
+
+      len_type offset{};
+      len_type length{};
+      kind     type{ none };
+    };
+
+    //
+    // Recorded message
+    //
+    struct record
+    {
+      time_point time{};
+      len_type   fmtLen{};
+      len_type   textLen{};
+      std::uint8_t lvl{};
+      std::uint8_t cat{};
+      std::uint8_t argc{};
+      bool       truncated{};
+      std::array<arg, maxArgs>    args{};
+      std::array<char, textSize>  text{};
+    };
+
+    using ring_type = std::array<record, capacity>;
+
+  public:
+    CLASS_SPECIALS_NONE_CUSTOM(recorder);
+
+    recorder() noexcept;
+
+  public:
+    //
+    // Records a message
+    // The level and category are stored as is and
+    // are expected to be convertible to logging::level and logging::category
+    //
+    template <typename ...Args>
+    void add(std::uint8_t cat, std::uint8_t lvl, str_type fmt, const Args& ...args) noexcept
+    {
+      auto&& rec = m_ring[m_next % capacity];
+      ++m_next;
+
+      rec.time = clock_type::now();
+      rec.cat  = cat;
+      rec.lvl  = lvl;
+      rec.argc = 0;
+      rec.textLen = 0;
+      rec.truncated = false;
+      rec.fmtLen = static_cast<len_type>(store_text(rec, fmt));
+      (store_arg(rec, args), ...);
+    }
+
+    //
+    // Writes all recorded messages, oldest first, to the specified file
+    // Opens the file, so this is not to be used from signal handlers
+    //
+    void dump(const file_name& fname) const noexcept;
+
+    //
+    // Overwrites the crash file with all recorded messages
+    // Async-signal-safe
+    //
+    void dump() noexcept;
+
+    //
+    // Opens the crash file, looks up the current time zone offset,
+    // and installs handlers for fatal signals which dump the ring
+    // before the process dies
+    // The crash file is created if needed, but its contents are kept
+    // until the next dump
+    //
+    void arm(const file_name& fname) noexcept;
+
+    //
+    // Returns the number of recorded messages
+    //
+    size_type size() const noexcept;
+
+  private:
+    //
+    // Writes all recorded messages, oldest first, to an open file
+    //
+    void write_to(platform::raw_file& file) const noexcept;
+
+    //
+    // Copies a string into the record's text storage
+    // Returns the number of characters copied
+    //
+    static size_type store_text(record& rec, str_type str) noexcept;
+
+    //
+    // Appends an argument to the record
+    // Types which can't be copied cheaply are formatted in place
+    //
+    template <typename T>
+    static void store_arg(record& rec, const T& val) noexcept
+    {
+      if (rec.argc == maxArgs)
+      {
+        rec.truncated = true;
+        return;
+      }
+
+      using type = std::remove_cvref_t<T>;
+      auto&& a = rec.args[rec.argc++];
+      if constexpr (std::is_same_v<type, bool>)
+      {
+        a.type = arg::boolean;
+        a.b = val;
+      }
+      else if constexpr (std::is_same_v<type, char>)
+      {
+        a.type = arg::character;
+        a.c = val;
+      }
+      else if constexpr (std::is_convertible_v<const T&, str_type>)
+      {
+        a.type   = arg::str;
+        a.offset = rec.textLen;
+        a.length = static_cast<len_type>(store_text(rec, str_type{ val }));
+      }
+      else if constexpr (std::is_integral_v<type> && std::is_signed_v<type>)
+      {
+        a.type = arg::sint;
+        a.i = val;
+      }
+      else if constexpr (std::is_integral_v<type>)
+      {
+        a.type = arg::uint;
+        a.u = val;
+      }
+      else if constexpr (std::is_same_v<type, float>)
+      {
+        a.type = arg::flt;
+        a.f = val;
+      }
+      else if constexpr (std::is_floating_point_v<type>)
+      {
+        a.type = arg::dbl;
+        a.d = static_cast<double>(val);
+      }
+      else if constexpr (std::is_pointer_v<type>)
+      {
+        a.type = arg::ptr;
+        a.p = val;
+      }
+      else
+      {
+        a.type   = arg::str;
+        a.offset = rec.textLen;
+        a.length = static_cast<len_type>(format_text(rec, val));
+      }
+    }
+
+    //
+    // Formats an argument into the record's text storage
+    // Returns the number of characters written
+    //
+    template <typename T>
+    static size_type format_text(record& rec, const T& val) noexcept
+    {
+      auto out = rec.text.data() + rec.textLen;
+      const auto avail = static_cast<std::ptrdiff_t>(textSize - rec.textLen);
+      try
+      {
+        const auto res = std::format_to_n(out, avail, "{}", val);
+        const auto written = std::min(res.size, avail);
+        rec.textLen += static_cast<len_type>(written);
+        return static_cast<size_type>(written);
+      }
+      catch (std::exception&)
+      {
+        return 0;
+      }
+    }
+
+  private:
+    //
+    // Message ring
+    //
+    ring_type m_ring{};
+
+    //
+    // Total number of recorded messages
+    //
+    size_type m_next{};
+
+    //
+    // File the ring is dumped to on crashes
+    //
+    platform::raw_file m_crashFile;
+
+    //
+    // Offset of the local time from UTC at the time of arming
+    //
+    off_type m_offset{};
+  };
+}
@@ -0,0 +1,136 @@
+//
+// Log time stamp
+//
+
+#pragma once
+
+namespace neko::logging
+{
+  //
+  // Cached time stamp for log messages
+  // Converting the current time to a local calendar date is expensive,
+  // so the date and time part is formatted once per second and reused
+  // Sub-second digits are appended to the cached prefix on every call
+  // The time zone offset is looked up only when the current one expires
+  // (e.g. on daylight saving changes), so getting a stamp never allocates
+  //
+  class time_stamp final
+  {
+  public:
+    using clock_type = std::chrono::system_clock;
+    using time_point = clock_type::time_point;
+    using sec_type   = std::chrono::sys_seconds;
+    using zone_ptr   = const std::chrono::time_zone*;
+    using off_type   = std::chrono::seconds;
+    using value_type = std::string_view;
+    using size_type  = value_type::size_type;
+
+    //
+    // Number of sub-second digits appended to the stamp
+    //
+    enum class precision : std::uint8_t
+    {
+      sec   = 0,
+      milli = 3,
+      micro = 6
+    };
+
+    using enum precision;
+
+  private:
+    //
+    // Enough for 'YYYY-MM-DD, HH:MM:SS.uuuuuu' with some headroom
+    //
+    static constexpr auto bufferSize = 40ull;
+
+    using buf_type = std::array<char, bufferSize>;
+
+  public:
+    CLASS_SPECIALS_NONE_CUSTOM(time_stamp);
+
+    time_stamp() noexcept;
+
+  public:
+    //
+    // Looks up the current time zone
+    // Called once when the logger initialises
+    //
+    void init() noexcept;
+
+    //
+    // Sets the number of sub-second digits
+    // Returns the previously set one
+    //
+    precision set_precision(precision p) noexcept;
+
+    //
+    // Returns the stamp corresponding to the current time
+    // The returned view stays valid until the next call
+    //
+    value_type get() noexcept;
+
+    //
+    // Returns the stamp corresponding to the specified time point
+    // The returned view stays valid until the next call
+    //
+    value_type get(time_point tp) noexcept;
+
+  private:
+    //
+    // Formats the date and time part into the cache
+    //
+    void refresh(sec_type sec) noexcept;
+
+    //
+    // Looks up the time zone offset in effect at the specified time
+    //
+    void update_offset(sec_type sec) noexcept;
+
+    //
+    // Appends sub-second digits after the cached prefix
+    //
+    void append_fraction(time_point tp, sec_type sec) noexcept;
+
+  private:
+    //
+    // Stamp buffer. Holds the cached prefix followed by the fraction
+    //
+    buf_type  m_buf{};
+
+    //
+    // Time zone used to convert to local time
+    //
+    zone_ptr  m_zone{};
+
+    //
+    // The second the cached prefix corresponds to
+    //
+    sec_type  m_sec{};
+
+    //
+    // Offset of the local time from UTC
+    //
+    off_type  m_offset{};
+
+    //
+    // Range of time the current offset is valid for
+    //
+    sec_type  m_infoBegin{};
+    sec_type  m_infoEnd{};
+
+    //
+    // Length of the cached prefix
+    //
+    size_type m_prefixLen{};
+
+    //
+    // Length of the full stamp
+    //
+    size_type m_len{};
+
+    //
+    // Number of sub-second digits
+    //
+    precision m_precision{ milli };
+  };
+}
@@ -4,18 +4,44 @@
 
 #pragma once
 #include "core/singleton_base.hpp"
+#include "managers/event.hpp"
+#include "events/config_events.hpp"
+#include "platform/file_watch.hpp"
 
 namespace neko
 {
   namespace config
   {
     class cfg;
+    class section;
   }
 
   //
   // Configuration manager
   // Maintains a dictionary of all active configuration files
   //
+  // Loaded files are watched for changes. A changed file is reparsed on
+  // a worker thread, and the new tree is swapped in by update(), which
+  // the core calls between frames. Consumers are notified by the
+  // evt::config_changed event. Any pointers into the old tree, including
+  // the config container itself, are invalid by then and must be
+  // looked up again
+  // Trees are built from copies of the files rather than mappings (see
+  // cfg::storage), so saving a file never changes a tree in use
+  //
+  // Configs are also published as immutable snapshots (see acquire).
+  // A snapshot is reference-counted and keeps its version of the config
+  // alive for as long as it's held, reloads or not, so it can be read
+  // from any thread without locks. Each reload of a file publishes its
+  // next version. Loading, update() and includes() are for the thread
+  // which owns the manager; raw pointers they hand out are for that
+  // thread only
+  //
+  // A section can include other files by listing their paths in its
+  // include option: include{ 'units/tanks.cfg', 'units/planes.cfg' }
+  // Included files are loaded on first access (see includes) and are
+  // regular configs from then on, registered under their paths
+  //
   class conf_manager final : private singleton<conf_manager>
   {
   private:
@@ -31,15 +57,96 @@ namespace neko
     //
     using cfg_type   = config::cfg;
 
+  public:
+    //
+    // Version number of a config
+    // The first loaded version is 1, each reload adds one
+    //
+    using version_type = std::uint64_t;
+
+    //
+    // An immutable published version of a config
+    // Empty if there's no config
+    //
+    class snapshot final
+    {
+    public:
+      using ptr_type = std::shared_ptr<const cfg_type>;
+
+    public:
+      CLASS_SPECIALS_ALL(snapshot);
+
+      snapshot(ptr_type conf, version_type version) noexcept :
+        m_conf{ std::move(conf) },
+        m_version{ version }
+      { }
+
+      explicit operator bool() const noexcept
+      {
+        return static_cast<bool>(m_conf);
+      }
+
+      const cfg_type& operator*() const noexcept
+      {
+        NEK_ASSERT(m_conf);
+        return *m_conf;
+      }
+
+      const cfg_type* operator->() const noexcept
+      {
+        return get();
+      }
+
+    public:
+      //
+      // Returns the config
+      // nullptr if the snapshot is empty
+      //
+      const cfg_type* get() const noexcept
+      {
+        return m_conf.get();
+      }
+
+      //
+      // Returns the version of the config
+      // Zero if the snapshot is empty
+      //
+      version_type version() const noexcept
+      {
+        return m_version;
+      }
+
+    private:
+      ptr_type     m_conf;
+      version_type m_version{};
+    };
+
+  private:
     //
     // Storage type for config containers
     //
-    using store_type = std::unordered_map<key_type, cfg_type>;
+    using store_type = std::unordered_map<key_type, snapshot>;
+
+    //
+    // Published configs
+    // Never modified once published, replaced as a whole
+    //
+    using registry_ptr = std::shared_ptr<const store_type>;
 
     //
     // Store index type
     //
     using index_type = std::unordered_map < path_type, key_type, path_hasher> ;
+
+    //
+    // Config change event
+    //
+    using change_evt = evt::config_changed;
+
+    //
+    // Configs reparsed by the worker, waiting to be swapped in
+    //
+    using reload_list = std::vector<std::pair<path_type, cfg_type>>;
     
     //
     // Helper for an optional value
@@ -52,6 +159,61 @@ namespace neko
     //
     using key_opt = res_opt<key_type>;
 
+    //
+    // Configs included by a section
+    //
+    using include_list = std::vector<const cfg_type*>;
+
+    //
+    // Resolved includes of sections
+    //
+    using include_map  = std::unordered_map<const config::section*, include_list>;
+
+    //
+    // Storage for names of included files, which are used as keys
+    // Keys refer to the strings, so a node-based container is used
+    //
+    using name_store   = std::unordered_set<std::string>;
+
+  public:
+    //
+    // Outcome of loading a single file
+    //
+    enum class load_result : std::uint8_t
+    {
+      loaded,     // The file has been loaded
+      present,    // The file is already loaded under the same name
+      bad_path,   // The file doesn't exist
+      path_taken, // The file is already loaded under a different name
+      key_taken,  // The name is already used by a different file
+      failed      // The file couldn't be read or parsed
+    };
+
+    //
+    // A name and a path of a file to load
+    //
+    using load_item   = std::pair<key_type, path_type>;
+
+    //
+    // A batch of files to load
+    //
+    using load_batch  = std::span<const load_item>;
+
+    //
+    // Outcomes of loading a batch, one per file
+    //
+    using load_report = std::vector<load_result>;
+
+    //
+    // A view of configs included by a section
+    //
+    using include_span = std::span<const cfg_type* const>;
+
+    //
+    // Name of the option which lists included files
+    //
+    static constexpr auto includeOption = "include"sv;
+
   public:
     CLASS_SPECIALS_NONE(conf_manager);
 
@@ -73,10 +235,21 @@ namespace neko
     //
     // Tries to load a file by a path relative to the root directory
     // and associates a name with it
-    // Returns false if such element already exists
+    // Returns false if the name or the file is already used by another
+    // element, or if the file can't be loaded
     //
     bool load_file(key_type key, path_type fname) noexcept;
 
+    //
+    // Loads a batch of files in parallel
+    // Files are read and parsed on a pool of threads, and the results are
+    // registered in one go once all of them are done. If that fails,
+    // none of the files are registered
+    // Returns outcomes in the order of the batch, or an empty report
+    // if the batch couldn't be processed at all
+    //
+    load_report load_files(load_batch files) noexcept;
+
     //
     // Checks if the specified name is already used
     //
@@ -87,6 +260,38 @@ namespace neko
     //
     const cfg_type* lookup(key_type key) const noexcept;
 
+    //
+    // Returns the latest published version of a config
+    // The snapshot is empty if there's no config with this name
+    // Can be called from any thread. Never waits for files to be parsed,
+    // but std::atomic<std::shared_ptr> isn't lock-free, so it might
+    // briefly wait for publish to store a new registry
+    //
+    // See TEST(conf_manager, t_snapshots)
+    //
+    snapshot acquire(key_type key) const noexcept;
+
+    //
+    // Swaps in configs which have been reloaded since the last call
+    // and notifies consumers about the changes
+    // Does nothing if there are none
+    //
+    void update() noexcept;
+
+    //
+    // Returns configs included by a section
+    // Paths are relative to the root directory. On first access, the files
+    // are loaded as a batch and registered under their paths as written.
+    // Files which are loaded already, directly or through another
+    // include, are shared rather than parsed again. Files which can't be
+    // loaded are skipped
+    // Includes are resolved once per section. The result is valid until
+    // configs are reloaded by update()
+    //
+    // See TEST(conf_manager, t_includes)
+    //
+    include_span includes(const config::section& sec) noexcept;
+
   private:
     //
     // Searches the index to find out whether a path is already in use
@@ -99,6 +304,46 @@ namespace neko
     //
     path_type canonise(path_type path) const noexcept;
 
+    //
+    // Registers parsed configs of a batch and reports the outcomes
+    // Configs which are missing in the list failed to parse
+    //
+    void register_batch(load_batch files, std::span<const path_type> paths,
+                        std::span<res_opt<cfg_type>> loaded, load_report& report) noexcept;
+
+    //
+    // Adds a file to the watch list and starts the worker if it
+    // isn't running yet
+    //
+    void watch(const path_type& path) noexcept;
+
+    //
+    // Worker thread procedure
+    // Waits for file changes and reparses changed files
+    //
+    void watch_proc(std::stop_token stop) noexcept;
+
+    //
+    // Replaces a loaded config with a reloaded one
+    // and queues the change event
+    //
+    void swap_in(const path_type& path, cfg_type&& conf) noexcept;
+
+    //
+    // Returns a key for an included file
+    // Keys are the normalised paths as written in the include option
+    //
+    key_type include_key(const path_type& path);
+
+    //
+    // Publishes the current storage for other threads
+    // Readers keep seeing the previous registry if this fails
+    // Copies the whole storage, a hash node and a reference count bump
+    // per config. Called once per batch of loaded files and once per
+    // update with reloads, never per lookup
+    //
+    void publish() noexcept;
+
   private:
     //
     // Config container storage
@@ -110,9 +355,52 @@ namespace neko
     //
     index_type m_index;
 
+    //
+    // Storage as seen by other threads
+    //
+    std::atomic<registry_ptr> m_published;
+
     //
     // Root directory path
     //
     path_type m_root;
+
+    //
+    // Resolved includes
+    //
+    include_map m_included;
+
+    //
+    // Names included files are registered under
+    //
+    name_store  m_includeNames;
+
+    //
+    // Loaded file watcher
+    //
+    platform::file_watch m_watch;
+
+    //
+    // Guards the reload list
+    //
+    std::mutex  m_reloadLock;
+
+    //
+    // Configs reparsed by the worker
+    //
+    reload_list m_reloaded;
+
+    //
+    // Set when the reload list isn't empty
+    // Lets update() return without locking on most frames
+    //
+    std::atomic_bool m_hasReloaded{};
+
+    //
+    // Worker thread reparsing changed files
+    // Declared last, so that it is stopped before anything it uses
+    // is destroyed
+    //
+    std::jthread m_worker;
   };
 }
\ No newline at end of file
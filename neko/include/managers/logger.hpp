@@ -3,33 +3,53 @@
 //
 
 #pragma once
+#include "logger/category.hpp"
+#include "logger/stamp.hpp"
+#include "logger/log_file.hpp"
+#include "logger/format.hpp"
+#include "logger/limiter.hpp"
+#include "logger/recorder.hpp"
+#include "logger/json.hpp"
+#include "logger/buffer.hpp"
+#include "platform/console.hpp"
 
 namespace neko
 {
   //
   // Logger for the engine
   // Systems and user code can use it to post information to the application log
+  // Messages can be posted from any thread. Initialisation, configuration
+  // and shutdown are expected to happen on the main thread
   //
   class logger final
   {
   public:
     //
-    // Loggind level
+    // Logging level
     //
-    enum class level : std::uint8_t
-    {
-      off,
-      err,
-      warn,
-      msg,
-      dbg
-    };
-
+    using level = logging::level;
     using enum level;
 
-    using fmt_type  = std::string_view;
-    using buf_type  = std::string;
+    //
+    // Log category
+    //
+    using category = logging::category;
+
+    using fmt_type  = logging::fmt_string;
+    using fmt_str   = fmt_type::value_type;
+    using buf_type  = logging::fixed_buffer<1024ull>;
+    using blk_type  = logging::fixed_buffer<4096ull>;
     using file_name = fsys::path;
+    using stamp     = logging::time_stamp;
+    using precision = stamp::precision;
+    using file_type = logging::log_file;
+    using size_type = file_type::size_type;
+    using limiter   = logging::limiter;
+    using interval  = limiter::duration;
+    using recorder  = logging::recorder;
+    using output    = logging::output;
+    using level_opt = std::optional<level>;
+    using cat_lvls  = std::array<level_opt, logging::categoryCount>;
 
   public:
     CLASS_SPECIALS_NONE(logger);
@@ -47,44 +67,226 @@ namespace neko
         "[trace]"sv
       };
 
-      constexpr auto fmt = "=={1:%F, %H:%M:%OS}== {0:}: "sv;
+      constexpr auto fmt = "=={1:}== {0:}: "sv;
       const auto idx = static_cast<std::size_t>(lvl) - 1;
-      const auto zt = std::chrono::zoned_time{
-        std::chrono::current_zone(),
-        std::chrono::system_clock::now()
-      };
-
-      std::format_to(std::back_inserter(m_buf), fmt,
-                     severities[idx],
-                     zt);
+      m_buf.commit(std::format_to(m_buf.out(), fmt,
+                                  severities[idx],
+                                  m_stamp.get()));
     }
 
     //
     // Posts a message of the specified level
     // The fmt parameter is a format string (see std::format)
+    // Repeated and too frequent messages are filtered out before formatting
+    // Messages of all levels go to the flight recorder
+    // Messages can be posted from any thread, they are serialised by a lock
+    // Messages posted while the thread is already inside the logger
+    // (e.g. by an assertion failing in the logging path) are dropped
     //
     template <typename ...Args>
-    static void message(level lvl, fmt_type fmt, Args&& ...args) noexcept
+    static void message(category cat, level lvl, fmt_type fmt, Args&& ...args) noexcept
     {
-      if (lvl > m_lvl)
+      if (m_busy)
+        return;
+
+      std::scoped_lock lock{ m_lock };
+      busy_mark mark;
+      m_recorder.add(static_cast<std::uint8_t>(cat), static_cast<std::uint8_t>(lvl),
+                     fmt.str(), args...);
+
+      if (lvl > effective_level(cat))
       {
         return;
       }
 
+      const auto verdict = m_limiter.check(fmt.location(),
+                                           logging::fingerprint(fmt.str(), args...),
+                                           make_tag(cat, lvl),
+                                           lvl != err);
+      if (!verdict)
+      {
+        return;
+      }
+
+      report_repeats(verdict.repeated, verdict.repeatTag);
+      if (verdict.suppressed)
+      {
+        post(cat, lvl, "{} similar messages suppressed"sv, verdict.suppressed);
+      }
+
+      post(cat, lvl, fmt, std::forward<Args>(args)...);
+    }
+
+    //
+    // Marks the current thread as being inside the logger
+    // for the lifetime of the object
+    //
+    struct busy_mark
+    {
+      busy_mark() noexcept
+      {
+        m_busy = true;
+      }
+      ~busy_mark() noexcept
+      {
+        m_busy = false;
+      }
+    };
+
+    //
+    // Packs the category and level into a limiter tag
+    //
+    static auto make_tag(category cat, level lvl) noexcept
+    {
+      return static_cast<limiter::tag_type>(logging::to_index(cat) << 4 | static_cast<std::size_t>(lvl));
+    }
+
+    //
+    // Returns the runtime level of a category
+    //
+    static level effective_level(category cat) noexcept
+    {
+      return m_catLvl[logging::to_index(cat)].value_or(m_lvl);
+    }
+
+    //
+    // Posts a notice about a repeated message
+    // The tag identifies the category and level of the original message
+    //
+    static void report_repeats(size_type count, limiter::tag_type tag) noexcept
+    {
+      if (count)
+      {
+        const auto cat = static_cast<category>(tag >> 4);
+        const auto lvl = static_cast<level>(tag & 0xF);
+        post(cat, lvl, "Last message repeated {} times"sv, count);
+      }
+    }
+
+    //
+    // Formats a message as text
+    // Fields are appended after the message
+    //
+    template <typename ...Args>
+    static void text_message(level lvl, fmt_str fmt, Args&& ...args)
+    {
+      prologue(lvl);
+      auto out = m_buf.out();
+      out = std::vformat_to(out, fmt, std::make_format_args(args...));
+
+      auto sep = " | "sv;
+      auto append = [&out, &sep](const auto& arg)
+      {
+        if constexpr (logging::is_field<std::remove_cvref_t<decltype(arg)>>)
+        {
+          out = std::format_to(out, "{}{}", sep, arg);
+          sep = ", "sv;
+        }
+      };
+      (append(args), ...);
+      m_buf.commit(out);
+    }
+
+    //
+    // Formats a message as a JSON object
+    // Everything is written straight into the buffer, the message text
+    // is escaped as it is formatted
+    //
+    template <typename ...Args>
+    static void json_message(category cat, level lvl, const fmt_type& fmt, Args&& ...args)
+    {
+      namespace json = logging::json;
+      const auto& loc = fmt.location();
+      const auto thread = std::hash<std::thread::id>{}(std::this_thread::get_id());
+
+      // Long strings are cut short to leave room for the rest of the object,
+      // fields which don't fit are dropped. The line end goes after it
+      constexpr auto reserve = std::size_t{ 128 };
+      constexpr auto closing = "}}"sv;
+      auto out = m_buf.out();
+      const auto last = out.last - 1;
+      out.last = last;
+
+      out = std::format_to(out, R"({{"time":"{}","level":"{}","category":"{}","file":")",
+                           m_stamp.get(), logging::to_string(lvl), logging::to_string(cat));
+      out = json::limited(out, reserve, [&loc](auto o) noexcept { return json::escape(o, loc.file_name()); });
+      out = std::format_to(out, R"(","line":{},"function":")", loc.line());
+      out = json::limited(out, reserve, [&loc](auto o) noexcept { return json::escape(o, loc.function_name()); });
+      out = std::format_to(out, R"(","thread":{},"message":")", thread);
+      out = json::limited(out, reserve, [&fmt, &args...](auto o)
+        {
+          using escaper = json::escaper<decltype(o)>;
+          return std::vformat_to(escaper{ o }, fmt.str(), std::make_format_args(args...)).base();
+        });
+      out = json::raw(out, R"(","fields":{)"sv);
+
+      out.last -= closing.size();
+      auto first = true;
+      auto member = [&out, &first](const auto& arg)
+      {
+        const auto prev = out;
+        out = json::member(out, first, arg);
+        if (out.cur == out.last)
+        {
+          out = prev;
+          out.stop();
+        }
+      };
+      (member(args), ...);
+
+      out.last = last;
+      m_buf.commit(json::raw(out, closing));
+    }
+
+    //
+    // Replaces a message which couldn't be formatted with an error report
+    // In JSON output, the report is an object with the call site of the
+    // original message and its format string in the 'format' field
+    //
+    static void failure(category cat, level lvl, const fmt_type& fmt, fmt_str what, std::string_view reason) noexcept
+    {
+      m_buf.clear();
       try
       {
-        prologue(lvl);
-        std::vformat_to(std::back_inserter(m_buf), fmt, std::make_format_args(std::forward<Args>(args)...));
+        if (m_output == output::json)
+        {
+          json_message(cat, lvl, fmt_type{ what, fmt.location() }, reason, logging::kv("format", fmt.str()));
+        }
+        else
+        {
+          m_buf.commit(std::vformat_to(m_buf.out(), what, std::make_format_args(reason)));
+        }
       }
-      catch (std::format_error& e)
+      catch (std::exception&)
       {
         m_buf.clear();
-        std::format_to(std::back_inserter(m_buf), "Bad format string: {}", e.what());
+      }
+    }
+
+    //
+    // Formats a message and adds it to the buffer
+    //
+    template <typename ...Args>
+    static void post(category cat, level lvl, const fmt_type& fmt, Args&& ...args) noexcept
+    {
+      try
+      {
+        if (m_output == output::json)
+        {
+          json_message(cat, lvl, fmt, args...);
+        }
+        else
+        {
+          text_message(lvl, fmt.str(), args...);
+        }
+      }
+      catch (std::format_error& e)
+      {
+        failure(cat, lvl, fmt, "Bad format string: {}"sv, e.what());
       }
       catch (std::runtime_error& e)
       {
-        m_buf.clear();
-        std::format_to(std::back_inserter(m_buf), "Runtime error: {}", e.what());
+        failure(cat, lvl, fmt, "Runtime error: {}"sv, e.what());
       }
       catch (std::bad_alloc& e)
       {
@@ -93,26 +295,19 @@ namespace neko
         return;
       }
       
-      m_stream  << m_buf << '\n';
-      std::cout << m_buf << '\n';
-
-      m_buf.clear();
-
-      if (m_stream.view().size() >= bufferSizeMax)
+      // Messages which don't fit are truncated, but always end the line
+      m_buf.terminate('\n');
+      if (m_block.space() < m_buf.size())
       {
         dump();
-        init_stream();
       }
-    }
 
-    //
-    // Reserves memory for the stream
-    //
-    static void init_stream() noexcept
-    {
-      std::string buf;
-      buf.reserve(bufferSizeMax);
-      m_stream.str(std::move(buf));
+      m_block.append(m_buf.view());
+      if (m_echo)
+      {
+        platform::console_write(m_buf.view());
+      }
+      m_buf.clear();
     }
 
   public:
@@ -126,17 +321,16 @@ namespace neko
 
     //
     // Initialises the logger
-    // Creates the underlying buffer and opens the log file for writing
+    // Opens the log file for writing
+    // Buffers are preallocated, posting messages after this doesn't allocate
     //
     static void init() noexcept
     {
-      init_stream();
-
-      constexpr auto initialSize = 256ull;
-      m_buf.reserve(initialSize);
-
-      m_file.open(m_fname.c_str());
+      m_stamp.init();
+      m_file.open(m_fname);
       NEK_ASSERT(good());
+
+      m_recorder.arm(crashFile);
     }
 
     //
@@ -145,8 +339,16 @@ namespace neko
     static void dump() noexcept
     {
       NEK_ASSERT(static_cast<bool>(m_file));
-      m_file << m_stream.rdbuf();
-      m_stream = {};
+      m_file.write(m_block.view());
+      m_block.clear();
+    }
+
+    //
+    // Writes recently posted messages of all levels to the crash file
+    //
+    static void dump_recent() noexcept
+    {
+      m_recorder.dump();
     }
 
     //
@@ -154,6 +356,7 @@ namespace neko
     //
     static void shutdown() noexcept
     {
+      report_repeats(m_limiter.flush_repeats(), m_limiter.last_tag());
       dump();
       m_file.close();
     }
@@ -170,6 +373,78 @@ namespace neko
       return prev;
     }
 
+    //
+    // Sets the number of sub-second digits in message time stamps
+    // Returns the previously set one
+    //
+    static precision set_time_precision(precision p) noexcept
+    {
+      return m_stamp.set_precision(p);
+    }
+
+    //
+    // Sets the size limit of the log file and the number of rotated
+    // files to keep (engine.1.log, engine.2.log, etc.)
+    //
+    static void set_rotation(size_type maxSize, size_type maxFiles) noexcept
+    {
+      m_file.set_rotation(maxSize, maxFiles);
+    }
+
+    //
+    // Sets the logging level of a category, overriding the common one
+    // Messages removed at compile time can't be enabled this way
+    // Returns the previously set one, if any
+    //
+    static level_opt set_category_level(category cat, level lvl) noexcept
+    {
+      return std::exchange(m_catLvl[logging::to_index(cat)], lvl);
+    }
+
+    //
+    // Resets the logging level of a category to the common one
+    //
+    static void reset_category_level(category cat) noexcept
+    {
+      m_catLvl[logging::to_index(cat)].reset();
+    }
+
+    //
+    // Sets the number of messages a single call site can post within
+    // the specified interval. Zero count disables rate limiting
+    // Errors are never limited
+    //
+    static void set_rate_limit(size_type count, interval period) noexcept
+    {
+      m_limiter.set_rate(count, period);
+    }
+
+    //
+    // Enables or disables collapsing of repeated messages
+    //
+    static void collapse_repeats(bool enable) noexcept
+    {
+      m_limiter.set_collapse(enable);
+    }
+
+    //
+    // Enables or disables duplicating messages to the console
+    // Returns the previous state
+    //
+    static bool echo(bool enable) noexcept
+    {
+      return std::exchange(m_echo, enable);
+    }
+
+    //
+    // Sets the output format
+    // Returns the previously set one
+    //
+    static output set_output(output fmt) noexcept
+    {
+      return std::exchange(m_output, fmt);
+    }
+
     //
     // Assigns a new file to write to
     //
@@ -178,11 +453,14 @@ namespace neko
       if (good())
       {
         dump();
+        m_file.close();
       }
 
       m_fname = std::move(fname);
       m_file.open(m_fname);
       NEK_ASSERT(good());
+
+      m_recorder.arm(crashFile);
     }
 
   #ifndef NDEBUG
@@ -192,10 +470,23 @@ namespace neko
     template <typename ...Args>
     static void trace(fmt_type fmt, Args&& ...args) noexcept
     {
-      message(dbg, fmt, std::forward<Args>(args)...);
+      message(category::core, dbg, fmt, std::forward<Args>(args)...);
     }
   #endif
 
+    //
+    // A message of the specified category and level
+    // Use the NEK_LOG macro to remove disabled messages at compile time
+    //
+    template <category Cat, level Lvl, typename ...Args>
+    static void log(fmt_type fmt, Args&& ...args) noexcept
+    {
+      if constexpr (logging::compiled_in<Cat, Lvl>)
+      {
+        message(Cat, Lvl, fmt, std::forward<Args>(args)...);
+      }
+    }
+
     //
     // A note (informational message)
     // Disabled in release builds by default
@@ -203,7 +494,7 @@ namespace neko
     template <typename ...Args>
     static void note(fmt_type fmt, Args&& ...args) noexcept
     {
-      message(msg, fmt, std::forward<Args>(args)...);
+      message(category::core, msg, fmt, std::forward<Args>(args)...);
     }
 
     //
@@ -213,7 +504,7 @@ namespace neko
     template <typename ...Args>
     static void warning(fmt_type fmt, Args&& ...args) noexcept
     {
-      message(warn, fmt, std::forward<Args>(args)...);
+      message(category::core, warn, fmt, std::forward<Args>(args)...);
     }
 
     //
@@ -223,25 +514,48 @@ namespace neko
     template <typename ...Args>
     static void error(fmt_type fmt, Args&& ...args) noexcept
     {
-      message(err, fmt, std::forward<Args>(args)...);
+      message(category::core, err, fmt, std::forward<Args>(args)...);
     }
 
     //
     // An abnormal termination message
     // Posted when normal logging is impossible (e.g. in an out of memory situation)
+    // In JSON output, it is written as an object like any other message
     //
     static void abnormal(std::string_view msg) noexcept
     {
       NEK_ASSERT(good());
       dump();
-      m_file << "Abnormal termination. " << msg << '\n';
+      if (m_output != output::json)
+      {
+        m_file.write("Abnormal termination. "sv);
+        m_file.write(msg);
+        m_file.write("\n"sv);
+        return;
+      }
+
+      // Written piece by piece, formatting might need memory we don't have
+      namespace json = logging::json;
+      m_buf.clear();
+      auto out = json::raw(m_buf.out(), R"({"time":")"sv);
+      out = json::raw(out, m_stamp.get());
+      out = json::raw(out, R"(","level":")"sv);
+      out = json::raw(out, logging::to_string(err));
+      out = json::raw(out, R"(","category":")"sv);
+      out = json::raw(out, logging::to_string(category::core));
+      out = json::raw(out, R"(","message":"Abnormal termination. )"sv);
+      out = json::escape(out, msg);
+      m_buf.commit(json::raw(out, R"("})"sv));
+      m_buf.terminate('\n');
+      m_file.write(m_buf.view());
+      m_buf.clear();
     }
 
   private:
     //
-    // We'll maintain buffer size of no more than 4Kb
+    // Flight recorder dump file name
     //
-    static constexpr auto bufferSizeMax = 4096ull;
+    static constexpr auto crashFile = "engine.crash.log"sv;
 
     //
     // Log file name
@@ -249,19 +563,63 @@ namespace neko
     inline static file_name m_fname{ "engine.log" };
 
     //
-    // Buffer for formatted messages
+    // Cached message time stamp
+    //
+    inline static stamp m_stamp;
+
+    //
+    // Rate limiter and duplicate filter
+    //
+    inline static limiter m_limiter;
+
+    //
+    // Flight recorder
+    //
+    inline static recorder m_recorder;
+
+    //
+    // Buffer for the message being formatted
+    // Messages longer than 1Kb are truncated
     //
     inline static buf_type  m_buf;
 
     //
-    // Underlying log buffer where messages are accumulated
+    // Block of formatted messages waiting to be written to the file
+    // Flushed when full, we'll maintain its size of no more than 4Kb
     //
-    inline static std::stringstream m_stream;
+    inline static blk_type  m_block;
 
     //
     // Log file currently written to
     //
-    inline static std::ofstream m_file;
+    inline static file_type m_file;
+
+    //
+    // Category levels overriding the common one
+    //
+    inline static cat_lvls  m_catLvl{};
+
+    //
+    // Serialises messages posted from different threads
+    //
+    inline static std::mutex m_lock;
+
+    //
+    // Set while the current thread holds the lock
+    // Asserts in the logging path post messages of their own,
+    // re-entering would deadlock on the lock
+    //
+    inline static thread_local bool m_busy{};
+
+    //
+    // Output format
+    //
+    inline static output m_output{ output::text };
+
+    //
+    // Whether messages are duplicated to the console
+    //
+    inline static bool m_echo{ true };
 
     //
     // Current logging level
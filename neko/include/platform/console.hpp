@@ -0,0 +1,15 @@
+//
+// Console output
+//
+
+#pragma once
+
+namespace neko::platform
+{
+  //
+  // Writes a string to the standard output directly, bypassing
+  // C and C++ stream buffers
+  // Doesn't allocate, output is silently dropped on failure
+  //
+  void console_write(std::string_view str) noexcept;
+}
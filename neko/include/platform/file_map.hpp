@@ -0,0 +1,123 @@
+//
+// Memory-mapped file
+//
+
+#pragma once
+
+namespace neko::platform
+{
+  //
+  // A file mapped into memory
+  // Read mappings cover the whole file and are never modified
+  // Write mappings are created with an explicit size and can be grown,
+  // the file is truncated to the actually used size when closed
+  //
+  class file_map final
+  {
+  public:
+    using size_type   = std::size_t;
+    using value_type  = char;
+    using handle_type = std::intptr_t;
+    using name_type   = fsys::path;
+
+  public:
+    file_map(const file_map&) = delete;
+    file_map& operator=(const file_map&) = delete;
+
+    file_map(file_map&& other) noexcept;
+    file_map& operator=(file_map&& other) noexcept;
+
+    ~file_map() noexcept;
+
+    file_map() noexcept;
+
+    //
+    // Checks whether the mapping is valid
+    //
+    explicit operator bool() const noexcept;
+
+  public:
+    //
+    // Maps an existing regular file for reading
+    // Fails on empty files and anything which isn't a regular file
+    //
+    bool open_read(const name_type& fname) noexcept;
+
+    //
+    // Creates (or truncates) a file of the specified size
+    // and maps it for writing
+    //
+    bool open_write(const name_type& fname, size_type size) noexcept;
+
+    //
+    // Grows a write mapping to the specified size
+    // The base address might change. The mapping stays as it was if this
+    // fails, and it's still closed with close(used)
+    //
+    bool resize(size_type size) noexcept;
+
+    //
+    // Unmaps the file
+    // Write mappings are truncated to the specified size
+    //
+    void close(size_type used) noexcept;
+
+    //
+    // Unmaps the file
+    // Write mappings keep their full size
+    //
+    void close() noexcept;
+
+    //
+    // Returns a pointer to the mapped memory
+    //
+    const value_type* data() const noexcept;
+
+    //
+    // Non-const version of data. Only valid for write mappings
+    //
+    value_type* data() noexcept;
+
+    //
+    // Returns the mapped size
+    //
+    size_type size() const noexcept;
+
+    //
+    // Checks whether this is a write mapping
+    //
+    bool writable() const noexcept;
+
+  private:
+    //
+    // Unmaps the view and releases native handles
+    //
+    void release(size_type used) noexcept;
+
+    //
+    // Swaps contents with another mapping
+    //
+    void swap(file_map& other) noexcept;
+
+  private:
+    //
+    // Mapped memory
+    //
+    value_type* m_data{};
+
+    //
+    // Mapped size
+    //
+    size_type m_size{};
+
+    //
+    // Native file handle (write mappings only)
+    //
+    handle_type m_file{ -1 };
+
+    //
+    // Native mapping handle (where the platform has one)
+    //
+    handle_type m_mapping{ -1 };
+  };
+}
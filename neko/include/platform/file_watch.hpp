@@ -0,0 +1,97 @@
+//
+// File change notifications
+//
+
+#pragma once
+
+namespace neko::platform
+{
+  //
+  // Watches a set of files for modifications
+  // Directories containing the files are watched rather than the files
+  // themselves, so that editors which save by writing a new file and
+  // renaming it over the old one are handled as well
+  //
+  // Files can be added from any thread while another one is waiting
+  //
+  class file_watch final
+  {
+  public:
+    using name_type   = fsys::path;
+    using name_list   = std::vector<name_type>;
+    using handle_type = std::intptr_t;
+    using time_type   = std::chrono::milliseconds;
+    using stamp_type  = fsys::file_time_type;
+
+  public:
+    CLASS_SPECIALS_NONE_CUSTOM(file_watch);
+
+    ~file_watch() noexcept;
+
+    file_watch() noexcept;
+
+    //
+    // Checks whether notifications are available
+    //
+    explicit operator bool() const noexcept;
+
+  public:
+    //
+    // Starts watching a file
+    // The path is expected to be canonical
+    //
+    bool add(const name_type& fname) noexcept;
+
+    //
+    // Waits for changes for at most the specified time
+    // Appends names of modified files to the list
+    // Returns false if the watch is broken and waiting is pointless
+    //
+    bool wait(name_list& changed, time_type timeout) noexcept;
+
+  private:
+    //
+    // A watched directory
+    //
+    struct dir_entry
+    {
+      handle_type handle;
+      name_type   path;
+    };
+
+    using dir_list = std::vector<dir_entry>;
+    using file_map = std::unordered_map<name_type, stamp_type, path_hasher>;
+
+    //
+    // Returns the entry of a watched directory, nullptr if there's none
+    //
+    const dir_entry* find_dir(const name_type& path) const noexcept;
+
+    //
+    // Collects watched files from the directory whose write times
+    // have changed since they were last seen
+    //
+    void collect(const name_type& dir, name_list& changed) noexcept;
+
+  private:
+    //
+    // Guards the directory and file lists
+    //
+    mutable std::mutex m_lock;
+
+    //
+    // Watched directories
+    //
+    dir_list    m_dirs;
+
+    //
+    // Watched files along with their last seen write times
+    //
+    file_map    m_files;
+
+    //
+    // Native notification handle (where the platform has one)
+    //
+    handle_type m_handle{ -1 };
+  };
+}
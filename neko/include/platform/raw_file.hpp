@@ -0,0 +1,76 @@
+//
+// Unbuffered file output
+//
+
+#pragma once
+
+namespace neko::platform
+{
+  //
+  // A file written directly through the OS, bypassing C and C++
+  // stream buffers
+  // Rewinding and writing don't allocate or take locks, so they
+  // can be done from signal handlers
+  //
+  class raw_file final
+  {
+  public:
+    using handle_type = std::intptr_t;
+    using name_type   = fsys::path;
+    using value_type  = std::string_view;
+
+  public:
+    raw_file(const raw_file&) = delete;
+    raw_file& operator=(const raw_file&) = delete;
+
+    ~raw_file() noexcept;
+
+    raw_file() noexcept;
+
+    //
+    // Checks whether the file is open
+    //
+    explicit operator bool() const noexcept;
+
+  public:
+    //
+    // Opens a file for writing, creating it if it doesn't exist
+    // Existing contents are kept until the file is rewound
+    //
+    bool open(const name_type& fname) noexcept;
+
+    //
+    // Truncates the file and moves to its beginning
+    //
+    bool rewind() noexcept;
+
+    //
+    // Writes a string at the current position
+    // Returns false if it couldn't be written in full
+    //
+    bool write(value_type str) noexcept;
+
+    //
+    // Flushes written data through to the disk
+    // Not safe to call from signal handlers
+    //
+    bool sync() noexcept;
+
+    //
+    // Closes the file
+    //
+    void close() noexcept;
+
+  private:
+    //
+    // Releases the native handle
+    //
+    void release() noexcept;
+
+  private:
+    //
+    // Native file handle
+    //
+    handle_type m_file{ -1 };
+  };
+}
@@ -0,0 +1,6 @@
+#pragma once
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
@@ -4,6 +4,7 @@
 #include <type_traits>
 #include <concepts>
 #include <utility>
+#include <bit>
 #include <source_location>
 
 #include <iostream>
@@ -13,6 +14,7 @@
 #include <string_view>
 
 #include <array>
+#include <span>
 #include <vector>
 #include <map>
 #include <unordered_map>
@@ -21,14 +23,24 @@
 #include <stack>
 #include <queue>
 #include <bitset>
+#include <limits>
+#include <cmath>
 
 #include <optional>
 #include <variant>
 
 #include <filesystem>
 #include <memory>
+#include <memory_resource>
 #include <new>
 
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <shared_mutex>
+#include <atomic>
+#include <stop_token>
+
 #include <format>
 
 #include <exception>
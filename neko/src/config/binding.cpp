@@ -0,0 +1,72 @@
+#include "config/binding.hpp"
+
+namespace neko::config::detail
+{
+  namespace
+  {
+    //
+    // Returns the item at a cached position if it has the expected name
+    //
+    template <typename T>
+    const T* at(std::span<const T* const> items, field_slot::pos_type pos, query::name_type name) noexcept
+    {
+      if (pos >= items.size())
+        return {};
+
+      auto item = items[pos];
+      return item->name() == name ? item : nullptr;
+    }
+
+    //
+    // Returns the position of an item in its parent's list
+    //
+    template <typename T>
+    field_slot::pos_type position(std::span<const T* const> items, const T* item) noexcept
+    {
+      auto it = std::find(items.begin(), items.end(), item);
+      return static_cast<field_slot::pos_type>(it - items.begin());
+    }
+  }
+
+  const option* follow(const section& root, const query& path, const field_slot& slot) noexcept
+  {
+    auto cur = &root;
+    auto pos = slot.pos.begin();
+    for (auto&& seg : path.parents())
+    {
+      cur = at(cur->sections(), *pos++, seg.name);
+      if (!cur)
+        return {};
+    }
+
+    return at(cur->options(), *pos, path.leaf().name);
+  }
+
+  const option* locate(const section& root, const query& path, field_slot& slot) noexcept
+  {
+    slot.cached = false;
+    if (!path)
+      return {};
+
+    auto cur = &root;
+    auto pos = slot.pos.begin();
+    for (auto&& seg : path.parents())
+    {
+      auto next = cur->get_section(seg.name, seg.hash);
+      if (!next)
+        return {};
+
+      *pos++ = position(cur->sections(), next);
+      cur = next;
+    }
+
+    auto&& leaf = path.leaf();
+    auto opt = cur->get_option(leaf.name, leaf.hash);
+    if (!opt)
+      return {};
+
+    *pos = position(cur->options(), opt);
+    slot.cached = true;
+    return opt;
+  }
+}
@@ -0,0 +1,492 @@
+#include "config/cache.hpp"
+#include "config/options/section.hpp"
+
+namespace neko::config
+{
+  namespace detail
+  {
+    //
+    // Image layout:
+    // [header][section records][option records][value records][strings]
+    // Sections are stored breadth-first, so children of any section
+    // occupy a contiguous range of records after it. Options of a section
+    // are contiguous as well, and so are values of an option
+    // All records are trivially copyable and naturally aligned
+    //
+    using u8  = std::uint8_t;
+    using u32 = std::uint32_t;
+    using u64 = std::uint64_t;
+
+    constexpr std::array<char, 4> imageMagic{ 'N', 'K', 'C', 'F' };
+
+    struct img_header
+    {
+      std::array<char, 4> magic;
+      u32 version;
+      u64 srcHash;
+      u32 secCount;
+      u32 optCount;
+      u32 valCount;
+      u32 strSize;
+      u32 secOff;
+      u32 optOff;
+      u32 valOff;
+      u32 strOff;
+    };
+
+    struct img_str
+    {
+      u32 off;
+      u32 len;
+    };
+
+    struct img_section
+    {
+      img_str name;
+      u32 firstSec;
+      u32 secCount;
+      u32 firstOpt;
+      u32 optCount;
+    };
+
+    struct img_option
+    {
+      img_str name;
+      u32 firstVal;
+      u32 valCount;
+    };
+
+    enum class img_type : u8
+    {
+      boolean,
+      integer,
+      real,
+      string
+    };
+
+    struct img_value
+    {
+      img_type type;
+      u32 len;
+      u64 bits;
+    };
+
+    static_assert(std::is_trivially_copyable_v<img_header>);
+    static_assert(sizeof(img_value) == 16);
+
+    //
+    // Reads a record at the specified offset
+    // Copying avoids relying on the alignment of the mapping
+    //
+    template <typename T>
+    T read_at(const char* base, std::size_t off) noexcept
+    {
+      T res;
+      std::memcpy(&res, base + off, sizeof(T));
+      return res;
+    }
+
+    template <typename T>
+    void write_at(char* base, std::size_t off, const T& rec) noexcept
+    {
+      std::memcpy(base + off, &rec, sizeof(T));
+    }
+
+    //
+    // Flattened section tree ready to be written out
+    //
+    struct img_builder
+    {
+      std::vector<img_section> sections;
+      std::vector<img_option>  options;
+      std::vector<img_value>   values;
+      std::string              strings;
+
+      img_str add_string(std::string_view str)
+      {
+        const img_str res{ static_cast<u32>(strings.size()), static_cast<u32>(str.size()) };
+        strings.append(str);
+        return res;
+      }
+
+      img_value make_value(const value& val)
+      {
+        img_value res{};
+        if (auto b = val.try_get<value::bool_val>())
+        {
+          res.type = img_type::boolean;
+          res.bits = *b;
+        }
+        else if (auto i = val.try_get<value::int_val>())
+        {
+          res.type = img_type::integer;
+          res.bits = static_cast<u64>(*i);
+        }
+        else if (auto f = val.try_get<value::float_val>())
+        {
+          res.type = img_type::real;
+          res.bits = std::bit_cast<u32>(*f);
+        }
+        else if (auto s = val.try_get<value::str_val>())
+        {
+          const auto str = add_string(*s);
+          res.type = img_type::string;
+          res.len  = str.len;
+          res.bits = str.off;
+        }
+        return res;
+      }
+
+      void build(const section& root)
+      {
+        std::vector<const section*> queue{ &root };
+        sections.push_back({ add_string(root.name()), 0, 0, 0, 0 });
+        for (std::size_t idx = 0; idx < queue.size(); ++idx)
+        {
+          auto sec = queue[idx];
+          const auto opts     = sec->options();
+          const auto children = sec->sections();
+          auto&& rec = sections[idx];
+          rec.firstOpt = static_cast<u32>(options.size());
+          rec.optCount = static_cast<u32>(opts.size());
+          rec.firstSec = static_cast<u32>(sections.size());
+          rec.secCount = static_cast<u32>(children.size());
+          for (auto opt : opts)
+          {
+            const auto name = add_string(opt->name());
+            options.push_back({ name, static_cast<u32>(values.size()), static_cast<u32>(opt->size()) });
+            for (auto&& val : *opt)
+              values.push_back(make_value(val));
+          }
+
+          for (auto child : children)
+          {
+            queue.push_back(child);
+            sections.push_back({ add_string(child->name()), 0, 0, 0, 0 });
+          }
+        }
+      }
+    };
+
+    constexpr std::size_t align_up(std::size_t off) noexcept
+    {
+      constexpr auto alignment = alignof(u64);
+      return (off + alignment - 1) & ~(alignment - 1);
+    }
+
+    //
+    // Rebuilds a section tree from validated records
+    //
+    class img_loader
+    {
+    public:
+      img_loader(const char* base, const img_header& hdr) noexcept :
+        m_base{ base },
+        m_strings{ base + hdr.strOff },
+        m_hdr{ hdr }
+      { }
+
+      //
+      // Makes strings refer to a copy of the string table
+      //
+      void use_strings(const char* strings) noexcept
+      {
+        m_strings = strings;
+      }
+
+      //
+      // Checks that every record refers to existing records and strings,
+      // and that child ranges follow each other in breadth-first order,
+      // which rules out cycles and shared subtrees
+      //
+      bool validate() const noexcept
+      {
+        if (!m_hdr.secCount)
+          return false;
+
+        u32 nextSec = 1;
+        for (u32 idx = 0; idx < m_hdr.secCount; ++idx)
+        {
+          const auto sec = section_at(idx);
+          if (!str_ok(sec.name)
+              || sec.firstSec != nextSec
+              || !range_ok(sec.firstSec, sec.secCount, m_hdr.secCount)
+              || !range_ok(sec.firstOpt, sec.optCount, m_hdr.optCount))
+            return false;
+
+          nextSec += sec.secCount;
+        }
+
+        for (u32 idx = 0; idx < m_hdr.optCount; ++idx)
+        {
+          const auto opt = option_at(idx);
+          if (!str_ok(opt.name) || !range_ok(opt.firstVal, opt.valCount, m_hdr.valCount))
+            return false;
+        }
+
+        for (u32 idx = 0; idx < m_hdr.valCount; ++idx)
+        {
+          const auto val = value_at(idx);
+          if (val.type > img_type::string)
+            return false;
+
+          if (val.type == img_type::string && !str_ok({ static_cast<u32>(val.bits), val.len }))
+            return false;
+        }
+
+        return true;
+      }
+
+      void load(section& dest, u32 idx)
+      {
+        const auto rec = section_at(idx);
+        for (auto optIdx = rec.firstOpt; optIdx < rec.firstOpt + rec.optCount; ++optIdx)
+        {
+          const auto optRec = option_at(optIdx);
+          auto&& opt = dest.add_option(string_at(optRec.name));
+          m_values.clear();
+          for (auto valIdx = optRec.firstVal; valIdx < optRec.firstVal + optRec.valCount; ++valIdx)
+          {
+            m_values.push_back(to_value(value_at(valIdx)));
+          }
+          opt.add_values(m_values);
+        }
+
+        for (auto secIdx = rec.firstSec; secIdx < rec.firstSec + rec.secCount; ++secIdx)
+        {
+          auto&& child = dest.add_section(string_at(section_at(secIdx).name));
+          load(child, secIdx);
+        }
+      }
+
+    private:
+      img_section section_at(u32 idx) const noexcept
+      {
+        return read_at<img_section>(m_base, m_hdr.secOff + idx * sizeof(img_section));
+      }
+      img_option option_at(u32 idx) const noexcept
+      {
+        return read_at<img_option>(m_base, m_hdr.optOff + idx * sizeof(img_option));
+      }
+      img_value value_at(u32 idx) const noexcept
+      {
+        return read_at<img_value>(m_base, m_hdr.valOff + idx * sizeof(img_value));
+      }
+      std::string_view string_at(img_str str) const noexcept
+      {
+        return { m_strings + str.off, str.len };
+      }
+
+      bool str_ok(img_str str) const noexcept
+      {
+        return str.off <= m_hdr.strSize && str.len <= m_hdr.strSize - str.off;
+      }
+      static bool range_ok(u32 first, u32 count, u32 total) noexcept
+      {
+        return first <= total && count <= total - first;
+      }
+
+      value to_value(img_value val) const noexcept
+      {
+        switch (val.type)
+        {
+        case img_type::boolean:
+          return value{ val.bits != 0 };
+        case img_type::integer:
+          return value{ static_cast<value::int_val>(val.bits) };
+        case img_type::real:
+          return value{ std::bit_cast<value::float_val>(static_cast<u32>(val.bits)) };
+        default:
+          return value{ string_at({ static_cast<u32>(val.bits), val.len }) };
+        }
+      }
+
+    private:
+      const char*        m_base{};
+      const char*        m_strings{};
+      img_header         m_hdr{};
+      std::vector<value> m_values;
+    };
+  }
+
+  // Special members
+
+  cfg_image::operator bool() const noexcept
+  {
+    return m_valid && static_cast<bool>(m_map);
+  }
+
+  // Public members
+
+  cfg_image::hash_type cfg_image::hash(data_type data) noexcept
+  {
+    // Consumes 8 bytes per step, sources are hashed on every load
+    auto res = keys::mix(data.size() ^ 0x9e3779b97f4a7c15ull);
+    auto cur = data.data();
+    auto left = data.size();
+    for (; left >= sizeof(hash_type); left -= sizeof(hash_type), cur += sizeof(hash_type))
+    {
+      res = keys::mix(res ^ detail::read_at<hash_type>(cur, 0));
+    }
+
+    hash_type tail{};
+    if (left)
+      std::memcpy(&tail, cur, left);
+    return keys::mix(res ^ tail);
+  }
+
+  cfg_image::name_type cfg_image::name_for(const name_type& source) noexcept
+  {
+    auto res = source;
+    res += ".nkc";
+    return res;
+  }
+
+  bool cfg_image::write(const name_type& fname, const section& root, hash_type srcHash) noexcept
+  {
+    using namespace detail;
+    img_builder builder;
+    try
+    {
+      builder.build(root);
+    }
+    catch (std::bad_alloc&)
+    {
+      return false;
+    }
+
+    img_header hdr{};
+    hdr.magic    = imageMagic;
+    hdr.version  = version;
+    hdr.srcHash  = srcHash;
+    hdr.secCount = static_cast<u32>(builder.sections.size());
+    hdr.optCount = static_cast<u32>(builder.options.size());
+    hdr.valCount = static_cast<u32>(builder.values.size());
+    hdr.strSize  = static_cast<u32>(builder.strings.size());
+    hdr.secOff   = static_cast<u32>(align_up(sizeof(img_header)));
+    hdr.optOff   = static_cast<u32>(align_up(hdr.secOff + hdr.secCount * sizeof(img_section)));
+    hdr.valOff   = static_cast<u32>(align_up(hdr.optOff + hdr.optCount * sizeof(img_option)));
+    hdr.strOff   = static_cast<u32>(hdr.valOff + hdr.valCount * sizeof(img_value));
+    const auto total = std::size_t{ hdr.strOff } + hdr.strSize;
+    if (total > std::numeric_limits<u32>::max())
+      return false;
+
+    // Written next to the destination and renamed over it, so a reader
+    // either sees the old image or the complete new one
+    auto tmpName = fname;
+    tmpName += ".tmp";
+    map_type out;
+    if (!out.open_write(tmpName, total))
+      return false;
+
+    auto base = out.data();
+    std::memset(base, 0, total);
+    write_at(base, 0, hdr);
+    auto writeAll = [base](std::size_t off, const auto& recs) noexcept
+      {
+        for (auto&& rec : recs)
+        {
+          write_at(base, off, rec);
+          off += sizeof(rec);
+        }
+      };
+    writeAll(hdr.secOff, builder.sections);
+    writeAll(hdr.optOff, builder.options);
+    writeAll(hdr.valOff, builder.values);
+    std::memcpy(base + hdr.strOff, builder.strings.data(), hdr.strSize);
+    out.close(total);
+
+    std::error_code err;
+    fsys::rename(tmpName, fname, err);
+    if (err)
+    {
+      fsys::remove(tmpName, err);
+      return false;
+    }
+
+    return true;
+  }
+
+  bool cfg_image::open(const name_type& fname) noexcept
+  {
+    close();
+    if (!m_map.open_read(fname))
+      return false;
+
+    m_valid = check();
+    if (!m_valid)
+      close();
+
+    return m_valid;
+  }
+
+  bool cfg_image::matches(hash_type srcHash) const noexcept
+  {
+    if (!*this)
+      return false;
+
+    const auto hdr = detail::read_at<detail::img_header>(m_map.data(), 0);
+    return hdr.srcHash == srcHash;
+  }
+
+  bool cfg_image::load(section& root, res_type* strings) const noexcept
+  {
+    if (!*this)
+      return false;
+
+    const auto base = m_map.data();
+    const auto hdr  = detail::read_at<detail::img_header>(base, 0);
+    detail::img_loader loader{ base, hdr };
+    if (!loader.validate())
+      return false;
+
+    try
+    {
+      if (strings && hdr.strSize)
+      {
+        auto copy = static_cast<char*>(strings->allocate(hdr.strSize, alignof(char)));
+        std::memcpy(copy, base + hdr.strOff, hdr.strSize);
+        loader.use_strings(copy);
+      }
+
+      loader.load(root, 0);
+    }
+    catch (std::bad_alloc&)
+    {
+      return false;
+    }
+
+    return true;
+  }
+
+  void cfg_image::close() noexcept
+  {
+    m_map.close();
+    m_valid = false;
+  }
+
+  // Private members
+
+  bool cfg_image::check() const noexcept
+  {
+    using namespace detail;
+    const auto size = m_map.size();
+    if (size < sizeof(img_header))
+      return false;
+
+    const auto hdr = read_at<img_header>(m_map.data(), 0);
+    if (hdr.magic != imageMagic || hdr.version != version)
+      return false;
+
+    // Sections must fit before options, options before values, and so on
+    auto fits = [](std::size_t off, std::size_t count, std::size_t recSize, std::size_t next) noexcept
+      {
+        return off >= sizeof(img_header) && off <= next && count <= (next - off) / recSize;
+      };
+
+    return hdr.strOff <= size && hdr.strSize <= size - hdr.strOff
+        && fits(hdr.secOff, hdr.secCount, sizeof(img_section), hdr.optOff)
+        && fits(hdr.optOff, hdr.optCount, sizeof(img_option), hdr.valOff)
+        && fits(hdr.valOff, hdr.valCount, sizeof(img_value), hdr.strOff);
+  }
+}
@@ -5,11 +5,20 @@ namespace neko::config
 {
   // Special members
 
-  cfg::cfg(file_name fname) noexcept :
-    m_file{ std::move(fname) },
-    m_root{ parser::root_name }
+  cfg::cfg(file_name fname, cache_policy cache, storage store) noexcept :
+    m_file{ std::move(fname), store },
+    m_arena{ make_arena(m_file) },
+    m_root{ parser::root_name, *m_arena }
   {
-    read();
+    read(cache);
+  }
+
+  cfg::cfg(file_name fname, size_type chunkSize) noexcept :
+    m_file{ std::move(fname), chunkSize },
+    m_arena{ make_arena(m_file) },
+    m_root{ parser::root_name, *m_arena }
+  {
+    read(cache_policy::none);
   }
 
   cfg::operator bool() const noexcept
@@ -27,26 +36,98 @@ namespace neko::config
     return m_root;
   }
 
+  bool cfg::from_image() const noexcept
+  {
+    return m_fromImage;
+  }
+
   // Private members
 
-  void cfg::read() noexcept
+  void cfg::read(cache_policy cache) noexcept
   {
-    if (!parse())
+    const auto useCache  = cache == cache_policy::cached && static_cast<bool>(m_file);
+    const auto srcHash   = useCache ? image_type::hash(m_file.contents()) : image_type::hash_type{};
+    const auto fromImage = useCache && load_image(srcHash);
+    if (!fromImage && !parse())
     {
       m_file.discard();
       return;
     }
 
+    if (!m_root.freeze())
+    {
+      NEK_LOG(config, warn, "Lookup tables for some sections couldn't be built");
+    }
+
+    if (useCache && !fromImage)
+    {
+      store_image(srcHash);
+    }
+
     m_file.rewind();
   }
 
+  bool cfg::load_image(image_type::hash_type srcHash) noexcept
+  {
+    const auto imageName = image_type::name_for(m_file.name());
+    if (!m_image.open(imageName) || !m_image.matches(srcHash))
+    {
+      m_image.close();
+      return false;
+    }
+
+    // A copied file means the tree mustn't refer to the disk,
+    // so the strings are copied as well and the image isn't needed after
+    const auto detached = !m_file.mapped();
+    if (!m_image.load(m_root, detached ? m_arena.get() : nullptr))
+    {
+      NEK_LOG(config, warn, "Compiled config {} is corrupted", imageName.string());
+      m_image.close();
+      m_root = section{ parser::root_name, *m_arena };
+      return false;
+    }
+
+    if (detached)
+      m_image.close();
+
+    NEK_TRACE_IN(config, "Loaded compiled config {}", imageName.string());
+    m_fromImage = true;
+    return true;
+  }
+
+  void cfg::store_image(image_type::hash_type srcHash) noexcept
+  {
+    const auto imageName = image_type::name_for(m_file.name());
+    if (!image_type::write(imageName, m_root, srcHash))
+    {
+      NEK_LOG(config, warn, "Unable to write compiled config {}", imageName.string());
+    }
+  }
+
   bool cfg::parse() noexcept
   {
-    if (parser p{ m_file })
+    if (parser p{ m_file, *m_arena })
     {
       m_root = p.get();
       return true;
     }
     return false;
   }
+
+  cfg::arena_ptr cfg::make_arena(const file_type& file) noexcept
+  {
+    // Nodes take several times the space of their text
+    // If the estimate is short, the arena grows geometrically
+    constexpr auto sizeFactor = 4ull;
+    constexpr auto minSize    = 4096ull;
+    const auto size = std::max(file.size() * sizeFactor, minSize);
+    try
+    {
+      return std::make_unique<arena_type>(size);
+    }
+    catch (std::bad_alloc&)
+    {
+      return std::make_unique<arena_type>();
+    }
+  }
 }
\ No newline at end of file
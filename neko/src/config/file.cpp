@@ -1,57 +1,72 @@
 #include "config/file.hpp"
+#include "config/parser/scan.hpp"
 
 namespace neko::config
 {
   // Special members
 
-  cfg_file::cfg_file(name_type fname) noexcept :
+  cfg_file::cfg_file(name_type fname, storage store) noexcept :
     m_name{ std::move(fname) },
-    m_cur{ m_buf.begin() }
+    m_cur{ m_data.begin() }
   {
-    read();
+    read(store);
+  }
+
+  cfg_file::cfg_file(name_type fname, size_type chunkSize) noexcept :
+    m_name{ std::move(fname) },
+    m_cur{ m_data.begin() },
+    m_chunk{ std::max(chunkSize, size_type{ 1 }) }
+  {
+    stream();
   }
 
   cfg_file::operator bool() const noexcept
   {
-    return m_cur != m_buf.end();
+    return m_cur != m_data.end();
   }
 
   // Public members
 
   void cfg_file::rewind() noexcept
   {
-    m_cur = m_buf.begin();
+    m_cur = m_data.begin();
   }
   cfg_file::line_type cfg_file::consume(iterator upto) noexcept
   {
     auto ret = line_type{ m_cur, upto };
-    m_cur = upto;
+    m_cur  = upto;
+    m_last = ret;
     return ret;
   }
+  cfg_file::line_type cfg_file::last() const noexcept
+  {
+    return m_last;
+  }
 
   void cfg_file::discard() noexcept
   {
+    m_map.close();
+    m_stream.close();
     m_buf.clear();
-    m_cur = m_buf.end();
+    attach(nullptr, 0);
   }
 
   cfg_file::line_type cfg_file::line() noexcept
   {
     constexpr auto eol = '\n';
     auto it = m_cur;
-    for (; it != m_buf.end(); ++it)
+    while (it != m_data.end())
     {
-      if (*it == eol)
-      {
-        ++it;
-        if (utils::trim(line_type{ m_cur, it }).empty())
-        {
-          m_cur = it;
-          continue;
-        }
+      if (*it++ != eol)
+        continue;
 
-        break;
+      if (utils::trim(line_type{ m_cur, it }).empty())
+      {
+        m_cur = it;
+        continue;
       }
+
+      break;
     }
 
     auto res = utils::rtrim(line_type{ m_cur, it });
@@ -61,40 +76,171 @@ namespace neko::config
 
   cfg_file::char_type cfg_file::peek() noexcept
   {
-    auto it = m_cur;
-    while (it != m_buf.end())
+    for (;;)
     {
-      if (const auto c = *it; !std::isspace(c))
+      if (m_cur != m_data.end())
       {
-        m_cur = it;
-        return c;
+        const auto first = std::to_address(m_cur);
+        const auto last  = first + (m_data.end() - m_cur);
+        m_cur += scan::skip_space(first, last) - first;
+        if (m_cur != m_data.end())
+          return *m_cur;
       }
 
-      ++it;
+      if (!fetch())
+        return char_type{};
     }
+  }
 
-    if (it == m_buf.end())
-      m_cur = it;
+  bool cfg_file::mapped() const noexcept
+  {
+    return static_cast<bool>(m_map);
+  }
 
-    return char_type{};
+  bool cfg_file::streamed() const noexcept
+  {
+    return m_chunk != 0;
+  }
+
+  cfg_file::size_type cfg_file::size() const noexcept
+  {
+    return m_data.size();
+  }
+
+  cfg_file::line_type cfg_file::contents() const noexcept
+  {
+    return m_data;
+  }
+
+  const cfg_file::name_type& cfg_file::name() const noexcept
+  {
+    return m_name;
   }
 
   // Private members
 
-  void cfg_file::read() noexcept
+  void cfg_file::read(storage store) noexcept
   {
-    m_buf.clear();
-    in_type in{ m_name.string() };
+    discard();
+    if (store == storage::mapped && m_map.open_read(m_name))
+    {
+      attach(std::as_const(m_map).data(), m_map.size());
+      return;
+    }
+
+    copy();
+  }
+
+  void cfg_file::copy() noexcept
+  {
+    in_type in{ m_name, std::ios::binary };
     if (!in)
       return;
 
-    in.seekg(0, std::ios::end);
-    m_buf.reserve(in.tellg());
-    in.seekg(0, std::ios::beg);
-    
-    using it = std::istreambuf_iterator<buf_type::value_type>;
-    m_buf.assign(it{ in }, it{});
-    m_cur = m_buf.begin();
+    // The size of non-regular files is unknown upfront
+    constexpr auto chunkSize = 4096ull;
+    try
+    {
+      std::error_code err;
+      const auto fileSize = fsys::file_size(m_name, err);
+      if (!err)
+        m_buf.reserve(static_cast<size_type>(fileSize) + chunkSize);
+
+      while (in)
+      {
+        const auto size = m_buf.size();
+        m_buf.resize(size + chunkSize);
+        in.read(m_buf.data() + size, static_cast<std::streamsize>(chunkSize));
+        m_buf.resize(size + static_cast<size_type>(in.gcount()));
+      }
+    }
+    catch (std::bad_alloc&)
+    {
+      m_buf.clear();
+    }
+
+    attach(m_buf.data(), m_buf.size());
+  }
+
+  void cfg_file::stream() noexcept
+  {
+    discard();
+    m_stream.open(m_name, std::ios::binary);
+    if (!m_stream)
+      return;
+
+    try
+    {
+      m_buf.reserve(m_chunk * 2);
+    }
+    catch (std::bad_alloc&)
+    {
+      m_stream.close();
+      return;
+    }
+
+    fetch();
+  }
+
+  bool cfg_file::fetch() noexcept
+  {
+    if (!m_stream.is_open())
+      return false;
+
+    // Everything before the last consumed range is dropped,
+    // the rest of the buffer moves to its beginning
+    const auto base   = m_buf.data();
+    const auto curOff = static_cast<size_type>(m_cur - m_data.begin());
+    const auto keep   = m_last.data() ? static_cast<size_type>(m_last.data() - base) : curOff;
+    const auto from   = std::min(keep, curOff);
+    auto chunkEnd = size_type{};
+    try
+    {
+      m_buf.erase(m_buf.begin(), m_buf.begin() + from);
+      chunkEnd = m_buf.size();
+      for (;;)
+      {
+        const auto size = m_buf.size();
+        m_buf.resize(size + m_chunk);
+        m_stream.read(m_buf.data() + size, static_cast<std::streamsize>(m_chunk));
+        const auto count = static_cast<size_type>(m_stream.gcount());
+        m_buf.resize(size + count);
+        if (!m_stream)
+        {
+          chunkEnd = m_buf.size();
+          m_stream.close();
+          break;
+        }
+
+        // Cut after the last line break, a longer line makes the buffer grow
+        constexpr auto eol = '\n';
+        const auto lineEnd = line_type{ m_buf.data() + size, count }.rfind(eol);
+        if (lineEnd != line_type::npos)
+        {
+          chunkEnd = size + lineEnd + 1;
+          break;
+        }
+      }
+    }
+    catch (std::bad_alloc&)
+    {
+      discard();
+      return false;
+    }
+
+    m_data = { m_buf.data(), chunkEnd };
+    m_cur  = m_data.begin() + (curOff - from);
+    if (m_last.data())
+      m_last = { m_buf.data() + (keep - from), m_last.size() };
+
+    return m_cur != m_data.end();
+  }
+
+  void cfg_file::attach(const char_type* data, size_type size) noexcept
+  {
+    m_data = { data, size };
+    m_cur  = m_data.begin();
+    m_last = {};
   }
 
 }
\ No newline at end of file
@@ -0,0 +1,187 @@
+#include "config/options/names.hpp"
+
+namespace neko::config
+{
+  namespace detail
+  {
+    using entry     = name_id::entry;
+    using name_type = name_pool::name_type;
+    using hash_type = name_pool::hash_type;
+    using size_type = name_pool::size_type;
+
+    //
+    // Name with a precomputed hash used to look entries up
+    //
+    struct name_key
+    {
+      name_type str;
+      hash_type hash{};
+    };
+
+    //
+    // Link in a bucket chain
+    // Never changes once it's reachable from a bucket
+    //
+    struct node
+    {
+      const entry* e{};
+      const node*  next{};
+    };
+
+    using bucket = std::atomic<const node*>;
+
+    //
+    // Hash table of entries with a power of two number of buckets
+    // Only ever grows. Once full, it's replaced by a copy twice as big,
+    // and the old one stays around for readers which still hold it
+    //
+    struct table
+    {
+      size_type mask{};
+      bucket*   buckets{};
+    };
+
+    constexpr auto poolBlock   = size_type{ 64 * 1024 };
+    constexpr auto initBuckets = size_type{ 1024 };
+
+    //
+    // Interned names
+    // Entries, their strings and tables live in an arena which is never
+    // released, so interning rarely goes to the heap
+    //
+    // Readers only load the current table and walk its chains, which
+    // are published with release stores. Writers take the lock
+    //
+    struct pool_data
+    {
+      std::pmr::monotonic_buffer_resource mem{ poolBlock };
+      std::atomic<const table*>           current{};
+      std::atomic<size_type>              count{};
+      std::mutex                          lock;
+    };
+
+    //
+    // Never destroyed, so that names stay valid while static objects
+    // which refer to them are destroyed at exit
+    //
+    pool_data& pool() noexcept
+    {
+      static auto data = new pool_data;
+      return *data;
+    }
+
+    template <typename T>
+    T* make(pool_data& data, size_type count = 1)
+    {
+      return static_cast<T*>(data.mem.allocate(sizeof(T) * count, alignof(T)));
+    }
+
+    const entry* lookup(const table* tab, const name_key& key) noexcept
+    {
+      if (!tab)
+        return nullptr;
+
+      auto&& head = tab->buckets[static_cast<size_type>(key.hash) & tab->mask];
+      for (auto n = head.load(std::memory_order_acquire); n; n = n->next)
+      {
+        if (n->e->hash == key.hash && n->e->str == key.str)
+          return n->e;
+      }
+
+      return nullptr;
+    }
+
+    const entry* lookup(const pool_data& data, const name_key& key) noexcept
+    {
+      return lookup(data.current.load(std::memory_order_acquire), key);
+    }
+
+    //
+    // Adds an entry to the front of its chain in a table
+    //
+    void link(pool_data& data, const table& tab, const entry& e)
+    {
+      auto&& head = tab.buckets[static_cast<size_type>(e.hash) & tab.mask];
+      auto n = new (make<node>(data)) node{ &e, head.load(std::memory_order_relaxed) };
+      head.store(n, std::memory_order_release);
+    }
+
+    //
+    // Makes a table twice as big as the current one and publishes it
+    // Must be called under the lock
+    //
+    const table& grow(pool_data& data, const table* cur)
+    {
+      const auto size = cur ? (cur->mask + 1) * 2 : initBuckets;
+      auto buckets = make<bucket>(data, size);
+      for (auto idx = size_type{}; idx < size; ++idx)
+      {
+        std::construct_at(buckets + idx, nullptr);
+      }
+
+      auto tab = new (make<table>(data)) table{ size - 1, buckets };
+      if (cur)
+      {
+        for (auto idx = size_type{}; idx <= cur->mask; ++idx)
+        {
+          for (auto n = cur->buckets[idx].load(std::memory_order_relaxed); n; n = n->next)
+          {
+            link(data, *tab, *n->e);
+          }
+        }
+      }
+
+      data.current.store(tab, std::memory_order_release);
+      return *tab;
+    }
+  }
+
+  // Public members
+
+  name_id name_pool::intern(name_type name)
+  {
+    return intern(name, keys::hash(name));
+  }
+
+  name_id name_pool::intern(name_type name, hash_type hash)
+  {
+    const detail::name_key key{ name, hash };
+    auto&& data = detail::pool();
+    if (auto e = detail::lookup(data, key))
+      return name_id{ *e };
+
+    std::lock_guard lock{ data.lock };
+    auto cur = data.current.load(std::memory_order_relaxed);
+    if (auto e = detail::lookup(cur, key))
+      return name_id{ *e };
+
+    // Keep the load factor under 3/4
+    const auto count = data.count.load(std::memory_order_relaxed);
+    auto&& tab = (!cur || (count + 1) * 4 > (cur->mask + 1) * 3) ? detail::grow(data, cur) : *cur;
+
+    // Every name gets a buffer of its own, even an empty one, so that
+    // interned names can be told apart by address
+    auto buf = detail::make<char>(data, std::max(name.size(), size_type{ 1 }));
+    std::memcpy(buf, name.data(), name.size());
+    auto e = new (detail::make<detail::entry>(data)) detail::entry{ { buf, name.size() }, hash };
+    detail::link(data, tab, *e);
+    data.count.store(count + 1, std::memory_order_relaxed);
+    return name_id{ *e };
+  }
+
+  name_id name_pool::find(name_type name) noexcept
+  {
+    return find(name, keys::hash(name));
+  }
+
+  name_id name_pool::find(name_type name, hash_type hash) noexcept
+  {
+    auto e = detail::lookup(detail::pool(), { name, hash });
+    return e ? name_id{ *e } : name_id{};
+  }
+
+  name_pool::size_type name_pool::size() noexcept
+  {
+    return detail::pool().count.load(std::memory_order_relaxed);
+  }
+}
@@ -1,17 +1,73 @@
 #include "config/options/option.hpp"
+#include "config/options/section.hpp"
 
 namespace neko::config
 {
+  namespace detail
+  {
+    //
+    // Packs the values into a typed store if they all have its type
+    //
+    template <typename Store>
+    bool try_pack(option::store_type& dest, option::val_span vals, option::resource_type& res)
+    {
+      using val_type = typename Store::value_type;
+      if (!std::ranges::all_of(vals, [](const value& v) noexcept { return v.is<val_type>(); }))
+        return false;
+
+      auto&& store = dest.emplace<Store>(&res);
+      store.reserve(vals.size());
+      for (auto&& v : vals)
+        store.push_back(v.get<val_type>());
+
+      return true;
+    }
+  }
+
   // Special members
 
   option::option(name_type name, section& parent) noexcept :
     m_parent{ &parent },
-    m_name{ name }
+    m_name{ name },
+    m_values{ std::in_place_type<val_store>, &parent.resource() }
   {
   }
 
   // Public members
 
+  void option::add_values(val_span vals)
+  {
+    if (!size() && vals.size() >= packMin)
+    {
+      auto&& res = m_parent->resource();
+      if (detail::try_pack<int_store>(m_values, vals, res)
+       || detail::try_pack<float_store>(m_values, vals, res)
+       || detail::try_pack<bit_store>(m_values, vals, res))
+        return;
+    }
+
+    auto&& store = unpack();
+    store.insert(store.end(), vals.begin(), vals.end());
+  }
+
+  option::value_type option::value_at(size_type index) const noexcept
+  {
+    return std::visit([index](const auto& store) noexcept
+      {
+        return value_type{ store[index] };
+      }, m_values);
+  }
+
+  bool option::packed() const noexcept
+  {
+    return !std::holds_alternative<val_store>(m_values);
+  }
+
+  const option::bit_store* option::bits() const noexcept
+  {
+    return std::get_if<bit_store>(&m_values);
+  }
+
   option::name_type option::name() const noexcept
   {
     return m_name;
@@ -28,6 +84,21 @@ namespace neko::config
 
   option::size_type option::size() const noexcept
   {
-    return m_values.size();
+    return std::visit([](const auto& store) noexcept { return store.size(); }, m_values);
+  }
+
+  // Private members
+
+  option::val_store& option::unpack()
+  {
+    if (!packed())
+      return *std::get_if<val_store>(&m_values);
+
+    val_store vals{ &m_parent->resource() };
+    vals.reserve(size());
+    for (auto&& v : *this)
+      vals.push_back(v);
+
+    return m_values.emplace<val_store>(std::move(vals));
   }
-}
\ No newline at end of file
+}
@@ -4,14 +4,25 @@ namespace neko::config
 {
   // Special members
   section::section(name_type name) noexcept :
-    section{ name, nullptr }
+    section{ name, *std::pmr::get_default_resource() }
   { }
 
-  section::section(name_type name, section* parent) noexcept :
-    m_parent{ parent },
-    m_name{ name }
+  section::section(name_type name, resource_type& res) noexcept :
+    m_name{ name },
+    m_subsections{ &res },
+    m_options{ &res },
+    m_secOrder{ &res },
+    m_optOrder{ &res },
+    m_secTable{ res },
+    m_optTable{ res }
   { }
 
+  section::section(name_type name, section* parent) noexcept :
+    section{ name, parent ? parent->resource() : *std::pmr::get_default_resource() }
+  {
+    m_parent = parent;
+  }
+
   // Public members
 
   namespace detail
@@ -20,12 +31,11 @@ namespace neko::config
     struct getter
     {
       using value_type = T;
-      using name_type  = section::name_type;
-      using cont_type = std::unordered_map<name_type, value_type>;
+      using cont_type  = std::pmr::unordered_map<name_id, value_type>;
 
-      getter(const cont_type& cont, name_type name) noexcept
+      getter(const cont_type& cont, name_id id) noexcept
       {
-        if (auto it = cont.find(name); it != cont.end())
+        if (auto it = cont.find(id); it != cont.end())
         {
           value = &it->second;
         }
@@ -35,10 +45,21 @@ namespace neko::config
     };
   }
 
+  section::name_type section::name() const noexcept
+  {
+    return m_name;
+  }
+
   section& section::add_section(name_type name)
   {
-    auto item = m_subsections.emplace(name, section{ name, this });
-    return item.first->second;
+    NEK_ASSERT(!m_frozen);
+    const auto id = name_pool::intern(name);
+    auto [item, added] = m_subsections.emplace(id, section{ id.str(), this });
+    if (added)
+    {
+      m_secOrder.push_back(&item->second);
+    }
+    return item->second;
   }
   bool section::has_section(name_type name) const noexcept
   {
@@ -46,7 +67,38 @@ namespace neko::config
   }
   const section* section::get_section(name_type name) const noexcept
   {
-    return detail::getter{ m_subsections, name }.value;
+    return get_section(name, keys::hash(name));
+  }
+  const section* section::get_section(name_type name, hash_type hash) const noexcept
+  {
+    if (m_frozen)
+      return m_secTable.find(name, hash);
+
+    return get_section(name_pool::find(name, hash));
+  }
+  const section* section::get_section(name_id id) const noexcept
+  {
+    if (!id)
+      return {};
+
+    if (m_frozen)
+      return m_secTable.find_interned(id.str(), id.hash());
+
+    return detail::getter{ m_subsections, id }.value;
+  }
+  const section* section::get_section(const query& path) const noexcept
+  {
+    if (!path)
+      return {};
+
+    auto cur = this;
+    for (auto&& seg : path.segments())
+    {
+      cur = cur->get_section(seg.name, seg.hash);
+      if (!cur)
+        break;
+    }
+    return cur;
   }
   section* section::get_section(name_type name) noexcept
   {
@@ -55,8 +107,14 @@ namespace neko::config
   
   option& section::add_option(name_type name)
   {
-    auto item = m_options.emplace(name, option{ name, *this });
-    return item.first->second;
+    NEK_ASSERT(!m_frozen);
+    const auto id = name_pool::intern(name);
+    auto [item, added] = m_options.emplace(id, option{ id.str(), *this });
+    if (added)
+    {
+      m_optOrder.push_back(&item->second);
+    }
+    return item->second;
   }
   bool section::has_option(name_type name) const noexcept
   {
@@ -64,7 +122,40 @@ namespace neko::config
   }
   const option* section::get_option(name_type name) const noexcept
   {
-    return detail::getter{ m_options, name }.value;
+    return get_option(name, keys::hash(name));
+  }
+  const option* section::get_option(name_type name, hash_type hash) const noexcept
+  {
+    if (m_frozen)
+      return m_optTable.find(name, hash);
+
+    return get_option(name_pool::find(name, hash));
+  }
+  const option* section::get_option(name_id id) const noexcept
+  {
+    if (!id)
+      return {};
+
+    if (m_frozen)
+      return m_optTable.find_interned(id.str(), id.hash());
+
+    return detail::getter{ m_options, id }.value;
+  }
+  const option* section::get_option(const query& path) const noexcept
+  {
+    if (!path)
+      return {};
+
+    auto cur = this;
+    for (auto&& seg : path.parents())
+    {
+      cur = cur->get_section(seg.name, seg.hash);
+      if (!cur)
+        return {};
+    }
+
+    const auto& leaf = path.leaf();
+    return cur->get_option(leaf.name, leaf.hash);
   }
   option* section::get_option(name_type name) noexcept
   {
@@ -84,4 +175,44 @@ namespace neko::config
   {
     return !parent();
   }
+
+  section::resource_type& section::resource() const noexcept
+  {
+    return *m_subsections.get_allocator().resource();
+  }
+
+  section::sec_span section::sections() const noexcept
+  {
+    return m_secOrder;
+  }
+
+  section::opt_span section::options() const noexcept
+  {
+    return m_optOrder;
+  }
+
+  bool section::freeze() noexcept
+  {
+    // Parent links of the root's children point to wherever the root
+    // was built, fix them up in case it's been moved since
+    auto ok = true;
+    for (auto sec : m_secOrder)
+    {
+      auto child = utils::mutate(sec);
+      child->m_parent = this;
+      ok = child->freeze() && ok;
+    }
+    for (auto opt : m_optOrder)
+    {
+      utils::mutate(opt)->m_parent = this;
+    }
+
+    m_frozen = m_secTable.build(m_secOrder) && m_optTable.build(m_optOrder);
+    return m_frozen && ok;
+  }
+
+  bool section::frozen() const noexcept
+  {
+    return m_frozen;
+  }
 }
\ No newline at end of file
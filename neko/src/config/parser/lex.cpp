@@ -1,4 +1,6 @@
 #include "config/parser/lex.hpp"
+#include "config/parser/char_class.hpp"
+#include "config/parser/scan.hpp"
 
 namespace neko::config
 {
@@ -18,19 +20,38 @@ namespace neko::config
     constexpr auto bFalse = "false"sv;
 
     using char_type = lex::char_type;
-
-    constexpr auto is_id_char(char_type c) noexcept
-    {
-      return c == uscore || std::isalnum(c);
-    }
-    constexpr auto is_num_start(char_type c) noexcept
+    using file_iter = lex::file_iter;
+    using int_type  = lex::int_type;
+
+    //
+    // Runs a scanner (see scan.hpp) over the [from, to) range
+    // Returns an iterator to where the scanner has stopped
+    //
+    template <typename Scan>
+    file_iter skip(file_iter from, file_iter to, Scan scan) noexcept
     {
-      return utils::eq_any(c, plus, minus) || std::isdigit(c);
+      if (from == to)
+        return from;
+
+      const auto first = std::to_address(from);
+      const auto last  = first + (to - from);
+      return from + (scan(first, last) - first);
     }
-    constexpr auto is_delimiter(char_type c) noexcept
+
+    //
+    // Appends a digit to a negative accumulator
+    // Accumulating negatives allows representing the minimum value
+    // Returns false on overflow
+    //
+    constexpr bool add_digit(int_type& acc, char_type c) noexcept
     {
-      return utils::eq_any(c, comma, cOpen, cClose) ||
-             std::isspace(c);
+      constexpr auto minVal = std::numeric_limits<int_type>::min();
+      const auto digit = static_cast<int_type>(c - '0');
+      if (acc < (minVal + digit) / 10)
+        return false;
+
+      acc = acc * 10 - digit;
+      return true;
     }
   }
 
@@ -125,59 +146,54 @@ namespace neko::config
 
   bool lex::identifier() noexcept
   {
-    if (!good() || !std::isalpha(*m_to))
+    if (!good() || !chars::is(*m_to, chars::alpha))
       return false;
 
-    ++m_to;
-    while (good())
-    {
-      const auto c = *m_to;
-
-      if (detail::is_delimiter(c))
-        break;
-
-      if (!detail::is_id_char(c))
-        return false;
-
-      ++m_to;
-    }
-
-    return true;
+    m_to = detail::skip(m_to + 1, m_file.end(), scan::skip_ident);
+    return !good() || chars::is(*m_to, chars::delim);
   }
 
   lex::tok_id lex::number() noexcept
   {
     constexpr auto fail = token::unknown;
-    if (!good() || !detail::is_num_start(*m_to))
+    if (!good() || !chars::is(*m_to, chars::numStart))
       return fail;
 
-    ++m_to;
-    bool hasDot = false;
-    auto ret = token::intNum;
-    while (good())
+    const auto negative = *m_to == detail::minus;
+    if (chars::is(*m_to, chars::sign))
+      ++m_to;
+
+    // Integer part, accumulated right away
+    const auto intEnd = detail::skip(m_to, m_file.end(), scan::skip_digits);
+    auto hasDigits = intEnd != m_to;
+    auto overflow = false;
+    m_int = 0;
+    for (; m_to != intEnd; ++m_to)
     {
-      const auto c = *m_to;
+      overflow = overflow || !detail::add_digit(m_int, *m_to);
+    }
 
-      if (detail::is_delimiter(c))
-        break;
+    auto ret = token::intNum;
+    if (good() && *m_to == detail::dot)
+    {
+      ret = token::floatNum;
+      const auto fracEnd = detail::skip(m_to + 1, m_file.end(), scan::skip_digits);
+      hasDigits = hasDigits || fracEnd != m_to + 1;
+      m_to = fracEnd;
+    }
 
-      if (c == detail::dot)
-      {
-        if (!hasDot)
-        {
-          hasDot = true;
-          ret = token::floatNum;
-          ++m_to;
-          continue;
-        }
+    if (!hasDigits || (good() && !chars::is(*m_to, chars::delim)))
+      return fail;
 
-        return fail;
-      }
+    if (ret == token::intNum)
+    {
+      if (!negative && m_int == std::numeric_limits<int_type>::min())
+        overflow = true;
+      else if (!negative)
+        m_int = -m_int;
 
-      if (!std::isdigit(c))
+      if (overflow)
         return fail;
-
-      ++m_to;
     }
 
     return ret;
@@ -198,23 +214,14 @@ namespace neko::config
     if (!good() || *m_to != detail::quote)
       return false;
 
-    ++m_to;
-    while (good())
-    {
-      const auto c = *m_to;
+    m_to = detail::skip(m_to + 1, m_file.end(), scan::find_quote);
+    if (!good())
+      return true;
 
-      if (c == detail::eol)
-        return false;
-
-      if (c == detail::quote)
-      {
-        ++m_to;
-        break;
-      }
-
-      ++m_to;
-    }
+    if (*m_to == detail::eol)
+      return false;
 
+    ++m_to;
     return true;
   }
 
@@ -244,7 +251,15 @@ namespace neko::config
     }
 
     token ret{ val, id };
+    if (id == token::intNum)
+    {
+      ret.intVal = m_int;
+    }
+
+    // A streamed file might read the next chunk while skipping blanks,
+    // which moves the token
     fpeek();
+    ret.value = m_file.last();
     return ret;
   }
 }
\ No newline at end of file
@@ -7,18 +7,11 @@ namespace neko::config
   {
     using tok_type   = parser::token_type;
     using parser_val = parser::option_type::value_type;
-    using int_type   = parser_val::int_val;
     using flt_type   = parser_val::float_val;
     
     template <typename T>
     using opt = std::optional<T>;
 
-    template <typename T>
-    inline constexpr auto is_int = std::is_same_v<T, int_type>;
-
-    template <typename T>
-    inline constexpr auto is_float = std::is_same_v<T, flt_type>;
-
     using str_type = lex::tok_value;
 
     inline auto is_open_brace(lex& l) noexcept
@@ -31,36 +24,38 @@ namespace neko::config
       return tok.is(tok_type::curlyClose);
     }
 
-    template <typename T> requires (is_int<T> || is_float<T>)
-    opt<T> to(str_type str) noexcept
+    //
+    // Integers are converted by the lexer, only floats need parsing
+    // from_chars doesn't accept the leading +, so it is skipped
+    //
+    opt<flt_type> to_float(str_type str) noexcept
     {
+      if (str.starts_with('+'))
+        str.remove_prefix(1);
+
       auto begin = str.data();
       auto end = begin + str.length();
 
-      T result{};
+      flt_type result{};
       auto convRes = std::from_chars(begin, end, result);
-      if (convRes.ec != std::errc{ 0 })
+      if (convRes.ec != std::errc{ 0 } || convRes.ptr != end)
         return {};
 
       return result;
     }
-
-    auto to_int(str_type str) noexcept
-    {
-      return to<int_type>(str);
-    }
-    auto to_float(str_type str) noexcept
-    {
-      return to<flt_type>(str);
-    }
   }
 
   // Special members
 
   parser::parser(cfg_file& file) noexcept :
+    parser{ file, *std::pmr::get_default_resource() }
+  { }
+
+  parser::parser(cfg_file& file, res_type& res) noexcept :
     m_lexer{ file },
-    m_res{ root_name },
-    m_root{ &*m_res }
+    m_res{ std::in_place, root_name, res },
+    m_root{ &*m_res },
+    m_strings{ file.streamed() ? &res : nullptr }
   {
     if (!parse())
       m_res.reset();
@@ -91,7 +86,7 @@ namespace neko::config
     }
     return token;
   }
-  parser::token_type parser::body(option_type& opt) noexcept
+  parser::token_type parser::body(value_list& vals) noexcept
   {
     token_type token;
     bool commaExpected = false;
@@ -104,35 +99,31 @@ namespace neko::config
       switch (token.id)
       {
       case token_type::boolTrue:
-        opt.add_value(true);
+        vals.emplace_back(true);
         commaExpected = true;
         continue;
 
       case token_type::boolFalse:
-        opt.add_value(false);
+        vals.emplace_back(false);
         commaExpected = true;
         continue;
 
       case token_type::intNum:
-        if (auto iv = detail::to_int(token.value))
-        {
-          opt.add_value(*iv);
-          commaExpected = true;
-          continue;
-        }
-        break;
+        vals.emplace_back(token.intVal);
+        commaExpected = true;
+        continue;
       
       case token_type::floatNum:
         if (auto fv = detail::to_float(token.value))
         {
-          opt.add_value(*fv);
+          vals.emplace_back(*fv);
           commaExpected = true;
           continue;
         }
         break;
 
       case token_type::str:
-        opt.add_value(token.postproc_val());
+        vals.emplace_back(persist(token));
         commaExpected = true;
         continue;
       
@@ -168,8 +159,7 @@ namespace neko::config
     if (!token.is(token_type::section))
       return false;
 
-    auto name = token.postproc_val();
-    auto&& sec = m_root->add_section(name);
+    auto&& sec = m_root->add_section(token.postproc_val());
     if (!section_body(sec))
     {
       m_lexer.discard();
@@ -184,15 +174,19 @@ namespace neko::config
     if (!detail::is_open_brace(m_lexer))
       return false;
 
-    return detail::is_close_brace(body(opt));
+    m_values.clear();
+    if (!detail::is_close_brace(body(m_values)))
+      return false;
+
+    opt.add_values(m_values);
+    return true;
   }
   bool parser::option(token_type token) noexcept
   {
     if (!token.is(token_type::identifier))
       return false;
 
-    auto name = token.postproc_val();
-    auto&& opt = m_root->add_option(name);
+    auto&& opt = m_root->add_option(token.postproc_val());
     if (!option_values(opt))
     {
       m_lexer.discard();
@@ -229,4 +223,15 @@ namespace neko::config
 
     return true;
   }
+
+  parser::name_type parser::persist(token_type token) noexcept
+  {
+    auto val = token.postproc_val();
+    if (!m_strings || val.empty())
+      return val;
+
+    auto buf = static_cast<lex::char_type*>(m_strings->allocate(val.size(), alignof(lex::char_type)));
+    std::memcpy(buf, val.data(), val.size());
+    return { buf, val.size() };
+  }
 }
\ No newline at end of file
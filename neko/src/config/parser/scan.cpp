@@ -0,0 +1,136 @@
+#include "config/parser/scan.hpp"
+#include "config/parser/char_class.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+  #define NEK_SCAN_SSE2 1
+  #include <emmintrin.h>
+#else
+  #define NEK_SCAN_SSE2 0
+#endif
+
+namespace neko::config::scan
+{
+  namespace detail
+  {
+    //
+    // Skips characters of the specified classes one at a time
+    //
+    template <chars::mask_type Mask>
+    ptr_type skip_scalar(ptr_type first, ptr_type last) noexcept
+    {
+      while (first != last && chars::is(*first, Mask))
+      {
+        ++first;
+      }
+      return first;
+    }
+
+  #if NEK_SCAN_SSE2
+    using vec_type = __m128i;
+    constexpr auto width = std::ptrdiff_t{ sizeof(vec_type) };
+
+    inline vec_type load(ptr_type p) noexcept
+    {
+      return _mm_loadu_si128(reinterpret_cast<const vec_type*>(p));
+    }
+    inline vec_type eq(vec_type v, char c) noexcept
+    {
+      return _mm_cmpeq_epi8(v, _mm_set1_epi8(c));
+    }
+
+    //
+    // Marks bytes in the [lo, hi] range
+    // Comparisons are signed, which is fine for ASCII ranges
+    //
+    inline vec_type in_range(vec_type v, char lo, char hi) noexcept
+    {
+      const auto above = _mm_cmpgt_epi8(v, _mm_set1_epi8(static_cast<char>(lo - 1)));
+      const auto below = _mm_cmplt_epi8(v, _mm_set1_epi8(static_cast<char>(hi + 1)));
+      return _mm_and_si128(above, below);
+    }
+
+    //
+    // Returns a bit per byte which is NOT marked in the vector
+    //
+    inline unsigned unmarked(vec_type v) noexcept
+    {
+      return ~static_cast<unsigned>(_mm_movemask_epi8(v)) & 0xFFFFu;
+    }
+
+    //
+    // Goes over whole 16-byte blocks until a block has a stop character
+    // The matcher returns a bit mask of stop characters in a block
+    // Returns the position of the first stop character or the start
+    // of the incomplete tail block, which is left to the scalar code
+    //
+    template <typename Stop>
+    ptr_type run_blocks(ptr_type first, ptr_type last, Stop stop) noexcept
+    {
+      while (last - first >= width)
+      {
+        if (const auto mask = stop(load(first)))
+        {
+          return first + std::countr_zero(mask);
+        }
+        first += width;
+      }
+      return first;
+    }
+  #endif
+  }
+
+  ptr_type skip_space(ptr_type first, ptr_type last) noexcept
+  {
+  #if NEK_SCAN_SSE2
+    using namespace detail;
+    first = run_blocks(first, last, [](vec_type v) noexcept
+      {
+        return unmarked(_mm_or_si128(eq(v, ' '), in_range(v, '\t', '\r')));
+      });
+  #endif
+    return detail::skip_scalar<chars::space>(first, last);
+  }
+
+  ptr_type skip_ident(ptr_type first, ptr_type last) noexcept
+  {
+  #if NEK_SCAN_SSE2
+    using namespace detail;
+    first = run_blocks(first, last, [](vec_type v) noexcept
+      {
+        const auto letters = _mm_or_si128(in_range(v, 'a', 'z'), in_range(v, 'A', 'Z'));
+        const auto other   = _mm_or_si128(in_range(v, '0', '9'), eq(v, '_'));
+        return unmarked(_mm_or_si128(letters, other));
+      });
+  #endif
+    return detail::skip_scalar<chars::ident>(first, last);
+  }
+
+  ptr_type skip_digits(ptr_type first, ptr_type last) noexcept
+  {
+  #if NEK_SCAN_SSE2
+    using namespace detail;
+    first = run_blocks(first, last, [](vec_type v) noexcept
+      {
+        return unmarked(in_range(v, '0', '9'));
+      });
+  #endif
+    return detail::skip_scalar<chars::digit>(first, last);
+  }
+
+  ptr_type find_quote(ptr_type first, ptr_type last) noexcept
+  {
+  #if NEK_SCAN_SSE2
+    using namespace detail;
+    first = run_blocks(first, last, [](vec_type v) noexcept
+      {
+        const auto stop = _mm_or_si128(eq(v, '\''), eq(v, '\n'));
+        return static_cast<unsigned>(_mm_movemask_epi8(stop));
+      });
+  #endif
+    while (first != last && *first != '\'' && *first != '\n')
+    {
+      ++first;
+    }
+    return first;
+  }
+}
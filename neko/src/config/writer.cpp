@@ -0,0 +1,546 @@
+#include "config/writer.hpp"
+#include "config/parser/lex.hpp"
+#include "config/parser/char_class.hpp"
+#include "config/options/section.hpp"
+#include "platform/raw_file.hpp"
+
+namespace neko::config
+{
+  namespace detail
+  {
+    using text_type = cfg_writer::text_type;
+    using size_type = cfg_writer::size_type;
+    using str_type  = lex::tok_value;
+    using token     = lex::token;
+
+    constexpr auto indentWidth = size_type{ 2 };
+
+    //
+    // Checks whether the name is lexed as an identifier
+    //
+    bool is_ident(str_type name) noexcept
+    {
+      if (name.empty() || !chars::is(name.front(), chars::alpha))
+        return false;
+
+      if (name == "true"sv || name == "false"sv)
+        return false;
+
+      return std::ranges::all_of(name, [](char c) noexcept { return chars::is(c, chars::ident); });
+    }
+
+    //
+    // Spaces and tabs
+    //
+    constexpr bool is_blank(char c) noexcept
+    {
+      return c == ' ' || c == '\t' || c == '\r';
+    }
+
+    //
+    // Same as in the parser, from_chars doesn't accept the leading +
+    //
+    std::optional<value::float_val> parse_float(str_type str) noexcept
+    {
+      if (str.starts_with('+'))
+        str.remove_prefix(1);
+
+      auto begin = str.data();
+      auto end = begin + str.length();
+
+      value::float_val result{};
+      auto convRes = std::from_chars(begin, end, result);
+      if (convRes.ec != std::errc{ 0 } || convRes.ptr != end)
+        return {};
+
+      return result;
+    }
+
+    //
+    // Floats are written in fixed notation and always have a fraction,
+    // otherwise they'd be read back as integers
+    //
+    bool put_value(const value& val, text_type& out)
+    {
+      if (auto b = val.try_get<value::bool_val>())
+      {
+        out += *b ? "true"sv : "false"sv;
+        return true;
+      }
+
+      std::array<char, 64> buf;
+      const auto first = buf.data();
+      const auto last  = first + buf.size();
+      if (auto i = val.try_get<value::int_val>())
+      {
+        out.append(first, std::to_chars(first, last, *i).ptr);
+        return true;
+      }
+
+      if (auto f = val.try_get<value::float_val>())
+      {
+        if (!std::isfinite(*f))
+          return false;
+
+        const auto convRes = std::to_chars(first, last, *f, std::chars_format::fixed);
+        if (convRes.ec != std::errc{ 0 })
+          return false;
+
+        const str_type num{ first, convRes.ptr };
+        out += num;
+        if (num.find('.') == str_type::npos)
+          out += ".0"sv;
+
+        return true;
+      }
+
+      const auto str = val.get<value::str_val>();
+      if (str.find_first_of("'\n"sv) != str_type::npos)
+        return false;
+
+      out += '\'';
+      out += str;
+      out += '\'';
+      return true;
+    }
+
+    //
+    // Writes the value list of an option including the braces
+    //
+    bool put_values(const option& opt, text_type& out)
+    {
+      out += '{';
+      auto sep = " "sv;
+      for (auto&& val : opt)
+      {
+        out += sep;
+        if (!put_value(val, out))
+          return false;
+
+        sep = ", "sv;
+      }
+      out += " }"sv;
+      return true;
+    }
+
+    void put_indent(size_type depth, text_type& out)
+    {
+      out.append(depth * indentWidth, ' ');
+    }
+
+    bool put_option(const option& opt, size_type depth, text_type& out)
+    {
+      if (!is_ident(opt.name()))
+        return false;
+
+      put_indent(depth, out);
+      out += opt.name();
+      if (!put_values(opt, out))
+        return false;
+
+      out += '\n';
+      return true;
+    }
+
+    bool put_body(const section& sec, size_type depth, text_type& out);
+
+    bool put_section(const section& sec, size_type depth, text_type& out)
+    {
+      if (!is_ident(sec.name()))
+        return false;
+
+      put_indent(depth, out);
+      out += '.';
+      out += sec.name();
+      out += '\n';
+      put_indent(depth, out);
+      out += "{\n"sv;
+      if (!put_body(sec, depth + 1, out))
+        return false;
+
+      put_indent(depth, out);
+      out += "}\n"sv;
+      return true;
+    }
+
+    bool put_body(const section& sec, size_type depth, text_type& out)
+    {
+      for (auto opt : sec.options())
+      {
+        if (!put_option(*opt, depth, out))
+          return false;
+      }
+      for (auto sub : sec.sections())
+      {
+        if (!put_section(*sub, depth, out))
+          return false;
+      }
+      return true;
+    }
+
+    //
+    // Replacement of a byte range of the original text
+    //
+    struct text_edit
+    {
+      size_type from{};
+      size_type to{};
+      text_type text;
+    };
+
+    //
+    // Walks the original text alongside the tree and collects edits
+    // which turn the text into the serialised tree
+    // Edits are collected in text order and never overlap
+    //
+    class patcher final
+    {
+    public:
+      using edit_list  = std::vector<text_edit>;
+      using value_list = std::vector<value>;
+      using seen_set   = std::unordered_set<const void*>;
+
+    public:
+      CLASS_SPECIALS_NONE(patcher);
+
+      explicit patcher(cfg_file& file) noexcept :
+        m_lexer{ file },
+        m_text{ file.contents() }
+      { }
+
+    public:
+      //
+      // Compares the text with the tree
+      // Returns false if the text is malformed, has duplicate items,
+      // or the tree can't be represented
+      //
+      bool diff(const section& root)
+      {
+        size_type close{};
+        return body(&root, 0, close);
+      }
+
+      //
+      // Applies the edits to the original text
+      //
+      text_type apply() const
+      {
+        text_type res;
+        size_type from{};
+        for (auto&& edit : m_edits)
+        {
+          res += m_text.substr(from, edit.from - from);
+          res += edit.text;
+          from = edit.to;
+        }
+        res += m_text.substr(from);
+        return res;
+      }
+
+      //
+      // Checks whether the text matches the tree
+      //
+      bool unchanged() const noexcept
+      {
+        return m_edits.empty();
+      }
+
+    private:
+      size_type offset(const token& tok) const noexcept
+      {
+        return static_cast<size_type>(tok.value.data() - m_text.data());
+      }
+
+      //
+      // Goes through items of a section body
+      // The section is nullptr if it doesn't exist in the tree, in which
+      // case the body is only validated, since it's cut out as a whole
+      // Sets close to the position of the closing brace, or the end of text
+      // for the root
+      //
+      bool body(const section* sec, size_type depth, size_type& close)
+      {
+        seen_set seen;
+        for (;;)
+        {
+          if (!depth && !m_lexer)
+          {
+            close = m_text.size();
+            break;
+          }
+
+          const auto tok = m_lexer.next();
+          if (depth && tok.is(token::curlyClose))
+          {
+            close = offset(tok);
+            break;
+          }
+
+          auto ok = false;
+          if (tok.is(token::section))
+            ok = section_item(tok, sec, depth, seen);
+          else if (tok.is(token::identifier))
+            ok = option_item(tok, sec, seen);
+
+          if (!ok)
+            return false;
+        }
+
+        return !sec || add_missing(*sec, depth, close, seen);
+      }
+
+      bool section_item(const token& tok, const section* parent, size_type depth, seen_set& seen)
+      {
+        auto sec = parent ? parent->get_section(tok.postproc_val()) : nullptr;
+        if (sec && !seen.insert(sec).second)
+          return false;
+
+        if (!m_lexer.next().is(token::curlyOpen))
+          return false;
+
+        size_type close{};
+        if (!body(sec, depth + 1, close))
+          return false;
+
+        if (parent && !sec)
+          cut(offset(tok), close + 1);
+
+        return true;
+      }
+
+      bool option_item(const token& tok, const section* parent, seen_set& seen)
+      {
+        auto opt = parent ? parent->get_option(tok.postproc_val()) : nullptr;
+        if (opt && !seen.insert(opt).second)
+          return false;
+
+        const auto open = m_lexer.next();
+        if (!open.is(token::curlyOpen))
+          return false;
+
+        // Trailing commas are accepted, as they are by the parser
+        m_values.clear();
+        auto next = m_lexer.next();
+        while (!next.is(token::curlyClose))
+        {
+          if (!read_value(next))
+            return false;
+
+          next = m_lexer.next();
+          if (next.is(token::comma))
+            next = m_lexer.next();
+          else if (!next.is(token::curlyClose))
+            return false;
+        }
+
+        const auto close = offset(next);
+        if (!parent)
+          return true;
+
+        if (!opt)
+        {
+          cut(offset(tok), close + 1);
+          return true;
+        }
+
+        if (std::ranges::equal(m_values, *opt))
+          return true;
+
+        text_type text;
+        if (!put_values(*opt, text))
+          return false;
+
+        m_edits.push_back({ offset(open), close + 1, std::move(text) });
+        return true;
+      }
+
+      bool read_value(const token& tok)
+      {
+        switch (tok.id)
+        {
+        case token::boolTrue:
+          m_values.emplace_back(true);
+          return true;
+
+        case token::boolFalse:
+          m_values.emplace_back(false);
+          return true;
+
+        case token::intNum:
+          m_values.emplace_back(tok.intVal);
+          return true;
+
+        case token::floatNum:
+          if (auto fv = parse_float(tok.value))
+          {
+            m_values.emplace_back(*fv);
+            return true;
+          }
+          return false;
+
+        case token::str:
+          m_values.emplace_back(tok.postproc_val());
+          return true;
+
+        default:
+          return false;
+        }
+      }
+
+      //
+      // Removes a range of text
+      // If nothing else is on its line, the whole line goes
+      //
+      void cut(size_type from, size_type to)
+      {
+        auto lineFrom = from;
+        while (lineFrom && is_blank(m_text[lineFrom - 1]))
+          --lineFrom;
+
+        auto lineTo = to;
+        while (lineTo < m_text.size() && is_blank(m_text[lineTo]))
+          ++lineTo;
+
+        const auto startsLine = !lineFrom || m_text[lineFrom - 1] == '\n';
+        const auto endsLine = lineTo == m_text.size() || m_text[lineTo] == '\n';
+        if (startsLine && endsLine)
+        {
+          from = lineFrom;
+          to = std::min(lineTo + 1, m_text.size());
+        }
+
+        m_edits.push_back({ from, to, {} });
+      }
+
+      //
+      // Inserts items of the section which aren't in the text
+      // on separate lines before the closing brace
+      //
+      bool add_missing(const section& sec, size_type depth, size_type close, const seen_set& seen)
+      {
+        text_type text;
+        for (auto opt : sec.options())
+        {
+          if (!seen.contains(opt) && !put_option(*opt, depth, text))
+            return false;
+        }
+        for (auto sub : sec.sections())
+        {
+          if (!seen.contains(sub) && !put_section(*sub, depth, text))
+            return false;
+        }
+
+        if (text.empty())
+          return true;
+
+        // If the brace shares its line with other items, it is moved
+        // to a line of its own
+        auto at = close;
+        while (at && is_blank(m_text[at - 1]))
+          --at;
+
+        auto to = at;
+        if (at && m_text[at - 1] != '\n')
+        {
+          text.insert(text.begin(), '\n');
+          if (depth)
+            put_indent(depth - 1, text);
+
+          to = close;
+        }
+
+        m_edits.push_back({ at, to, std::move(text) });
+        return true;
+      }
+
+    private:
+      lex        m_lexer;
+      str_type   m_text;
+      edit_list  m_edits;
+      value_list m_values;
+    };
+  }
+
+  // Public members
+
+  bool cfg_writer::to_text(const section& root, text_type& out) noexcept
+  {
+    try
+    {
+      return detail::put_body(root, 0, out);
+    }
+    catch (std::bad_alloc&)
+    {
+      return false;
+    }
+  }
+
+  bool cfg_writer::save(const section& root, const name_type& fname) noexcept
+  {
+    text_type text;
+    if (!to_text(root, text))
+      return false;
+
+    return replace(fname, text);
+  }
+
+  bool cfg_writer::update(const section& root, const name_type& fname) noexcept
+  {
+    text_type text;
+    try
+    {
+      // The file has to be unmapped by the time it's replaced
+      cfg_file file{ fname };
+      if (!file.size())
+        return save(root, fname);
+
+      detail::patcher patch{ file };
+      if (!patch.diff(root))
+        return save(root, fname);
+
+      if (patch.unchanged())
+        return true;
+
+      text = patch.apply();
+    }
+    catch (std::bad_alloc&)
+    {
+      return false;
+    }
+
+    return replace(fname, text);
+  }
+
+  // Private members
+
+  bool cfg_writer::replace(const name_type& fname, std::string_view text) noexcept
+  {
+    name_type tmpName;
+    try
+    {
+      tmpName = fname;
+      tmpName += ".tmp";
+    }
+    catch (std::bad_alloc&)
+    {
+      return false;
+    }
+
+    // The data has to be on the disk before the rename, otherwise a crash
+    // could leave an empty file in place of the old one
+    platform::raw_file out;
+    const auto written = out.open(tmpName) && out.rewind() && out.write(text) && out.sync();
+    out.close();
+
+    std::error_code err;
+    if (written)
+    {
+      fsys::rename(tmpName, fname, err);
+      if (!err)
+        return true;
+    }
+
+    fsys::remove(tmpName, err);
+    return false;
+  }
+}
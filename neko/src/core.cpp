@@ -1,5 +1,6 @@
 #include "core/core.hpp"
 #include "game/base_game.hpp"
+#include "config/conf.hpp"
 
 #if NEK_WINDOWS
   #include "platform/windows/window.hpp"
@@ -71,6 +72,8 @@ namespace neko
       logger::error("Abnormal program termination");
     }
 
+    logger::dump_recent();
+
     on_exit();
   }
 }
@@ -110,7 +113,10 @@ namespace neko
     if (!systems::config().load_file("root", cfgRoot.filename()))
     {
       logger::error("Unable to open root config file");
+      return;
     }
+
+    configure_logger();
   }
 
   // Private members
@@ -166,6 +172,7 @@ namespace neko
   {
     while (poll_input())
     {
+      systems::config().update();
       m_game.update({});
 
       m_game.render();
@@ -184,6 +191,42 @@ namespace neko
     systems::shutdown_system<conf_manager>();
   }
 
+  void core::configure_logger() noexcept
+  {
+    auto rootCfg = systems::config().lookup("root");
+    if (!rootCfg)
+      return;
+
+    auto logSec = (*rootCfg)->get_section("log"sv);
+    if (!logSec)
+      return;
+
+    if (auto fmtOpt = logSec->get_option("format"sv))
+    {
+      const config::string_opt fmtName{ *fmtOpt };
+      if (fmtName && fmtName.value() == "json"sv)
+        logger::set_output(logger::output::json);
+    }
+
+    for (auto idx = 0ull; idx < logging::categoryCount; ++idx)
+    {
+      const auto cat = static_cast<logger::category>(idx);
+      auto opt = logSec->get_option(logging::to_string(cat));
+      if (!opt)
+        continue;
+
+      const config::string_opt lvlName{ *opt };
+      const auto lvl = lvlName ? logging::to_level(lvlName.value()) : logger::level_opt{};
+      if (!lvl)
+      {
+        logger::warning("Invalid log level for category '{}'", logging::to_string(cat));
+        continue;
+      }
+
+      logger::set_category_level(cat, *lvl);
+    }
+  }
+
   bool core::poll_input() noexcept
   {
     if (systems::app_host().update())
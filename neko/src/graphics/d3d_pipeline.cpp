@@ -48,14 +48,14 @@ namespace neko::platform
 
     d3d_target::~d3d_target() noexcept
     {
-      logger::note("Shutting down Direct3D pipeline");
+      NEK_LOG(render, msg, "Shutting down Direct3D pipeline");
       shutdown();
     }
 
     d3d_target::d3d_target(const host_info& info) noexcept :
       m_host{ info }
     {
-      logger::note("Initialising Direct3D pipeline");
+      NEK_LOG(render, msg, "Initialising Direct3D pipeline");
     }
 
     d3d_target::operator bool() const noexcept
@@ -90,7 +90,7 @@ namespace neko::platform
     bool d3d_target::enable_dbg() noexcept
     {
     #ifndef NDEBUG
-      NEK_TRACE("Initialising D3D debug mode");
+      NEK_TRACE_IN(render, "Initialising D3D debug mode");
       com_ptr<ID3D12Debug> dbg;
       D3D_ENSURE(D3D12GetDebugInterface(IID_PPV_ARGS(&dbg)), "D3D debug mode failed");
       dbg->EnableDebugLayer();
@@ -100,7 +100,7 @@ namespace neko::platform
 
     bool d3d_target::create_device() noexcept
     {
-      NEK_TRACE("Initialising D3D factory");
+      NEK_TRACE_IN(render, "Initialising D3D factory");
 
       constexpr std::uint32_t flags{
     #ifndef NDEBUG
@@ -125,7 +125,7 @@ namespace neko::platform
         return devOk && descr.DedicatedVideoMemory > vmem;
       };
 
-      NEK_TRACE("Enumerating hardware adapters");
+      NEK_TRACE_IN(render, "Enumerating hardware adapters");
       bool hwAdapterFound{};
       for (auto idx = 0u; m_factory->EnumAdapters1(idx, &adapter) != DXGI_ERROR_NOT_FOUND; ++idx)
       {
@@ -145,13 +145,13 @@ namespace neko::platform
         D3D_ENSURE(m_factory->EnumWarpAdapter(IID_PPV_ARGS(&adapter)), "Couldn't init WARP adapter");
       }
 
-      NEK_TRACE("Initialising D3D device");
+      NEK_TRACE_IN(render, "Initialising D3D device");
       D3D_ENSURE(D3D12CreateDevice(adapter.Get(), D3D_FEATURE_LEVEL_11_0, IID_PPV_ARGS(&m_device)), "D3D device failed");
 
     #ifndef NDEBUG
       if (com_ptr<ID3D12InfoQueue> infoQueue; SUCCEEDED(m_device.As(&infoQueue)))
       {
-        NEK_TRACE("Setting D3D debug parameters");
+        NEK_TRACE_IN(render, "Setting D3D debug parameters");
         infoQueue->SetBreakOnSeverity(D3D12_MESSAGE_SEVERITY_CORRUPTION, TRUE);
         infoQueue->SetBreakOnSeverity(D3D12_MESSAGE_SEVERITY_ERROR, TRUE);
         infoQueue->SetBreakOnSeverity(D3D12_MESSAGE_SEVERITY_WARNING, TRUE);
@@ -173,7 +173,7 @@ namespace neko::platform
     #endif
 
       m_RTVDescriptorSize = m_device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_RTV);
-      NEK_TRACE("RTV descriptor size: {}", m_RTVDescriptorSize);
+      NEK_TRACE_IN(render, "RTV descriptor size: {}", m_RTVDescriptorSize);
       return true;
     }
 
@@ -0,0 +1,121 @@
+#include "logger/limiter.hpp"
+
+namespace neko::logging
+{
+  // Special members
+
+  limiter::limiter() noexcept = default;
+
+  // Public members
+
+  limiter::verdict limiter::check(const loc_type& loc, hash_opt fp, tag_type tag, bool limited) noexcept
+  {
+    verdict res{};
+    if (m_collapse && repeats(loc, fp))
+    {
+      ++m_last.repeats;
+      return res;
+    }
+
+    if (limited && m_rate)
+    {
+      if (auto s = find_site(loc); s && !admit(*s, clock_type::now(), res))
+      {
+        return res;
+      }
+    }
+
+    res.repeatTag = m_last.tag;
+    res.repeated  = flush_repeats();
+    res.pass = true;
+
+    m_last.file   = loc.file_name();
+    m_last.line   = loc.line();
+    m_last.column = loc.column();
+    m_last.hash   = fp.value_or(hash_type{});
+    m_last.tag    = tag;
+    m_last.valid  = fp.has_value();
+
+    return res;
+  }
+
+  limiter::size_type limiter::flush_repeats() noexcept
+  {
+    return std::exchange(m_last.repeats, size_type{});
+  }
+
+  limiter::tag_type limiter::last_tag() const noexcept
+  {
+    return m_last.tag;
+  }
+
+  void limiter::set_rate(size_type count, duration interval) noexcept
+  {
+    m_rate = count;
+    m_interval = interval;
+    m_sites = {};
+  }
+
+  void limiter::set_collapse(bool enable) noexcept
+  {
+    m_collapse = enable;
+  }
+
+  // Private members
+
+  limiter::site* limiter::find_site(const loc_type& loc) noexcept
+  {
+    const auto file = loc.file_name();
+    auto hash = std::hash<const char*>{}(file);
+    detail::hash_combine(hash, loc.line());
+    detail::hash_combine(hash, loc.column());
+
+    constexpr auto mask = siteCount - 1;
+    static_assert((siteCount & mask) == 0, "Site count must be a power of 2");
+
+    for (auto probe = 0ull; probe < maxProbe; ++probe)
+    {
+      auto&& s = m_sites[(hash + probe) & mask];
+      if (!s.file)
+      {
+        s.file   = file;
+        s.line   = loc.line();
+        s.column = loc.column();
+        return &s;
+      }
+
+      if (s.file == file && s.line == loc.line() && s.column == loc.column())
+        return &s;
+    }
+
+    return nullptr;
+  }
+
+  bool limiter::admit(site& s, time_point now, verdict& res) noexcept
+  {
+    if (now - s.start >= m_interval)
+    {
+      res.suppressed = std::exchange(s.suppressed, size_type{});
+      s.start = now;
+      s.count = 0;
+    }
+
+    if (s.count >= m_rate)
+    {
+      ++s.suppressed;
+      return false;
+    }
+
+    ++s.count;
+    return true;
+  }
+
+  bool limiter::repeats(const loc_type& loc, hash_opt fp) const noexcept
+  {
+    return fp && m_last.valid &&
+           m_last.hash   == *fp &&
+           m_last.file   == loc.file_name() &&
+           m_last.line   == loc.line() &&
+           m_last.column == loc.column();
+  }
+}
@@ -0,0 +1,122 @@
+#include "logger/log_file.hpp"
+
+namespace neko::logging
+{
+  // Special members
+
+  log_file::~log_file() noexcept
+  {
+    close();
+  }
+
+  log_file::log_file() noexcept = default;
+
+  log_file::operator bool() const noexcept
+  {
+    return static_cast<bool>(m_map);
+  }
+
+  // Public members
+
+  bool log_file::open(name_type fname) noexcept
+  {
+    close();
+    m_name = std::move(fname);
+    return m_map.open_write(m_name, m_segment);
+  }
+
+  void log_file::close() noexcept
+  {
+    // A failed resize leaves the file open without a view, it still
+    // has to be truncated to what was written and closed
+    if (m_map.writable())
+    {
+      m_map.close(m_pos);
+    }
+
+    m_pos = 0;
+  }
+
+  void log_file::write(value_type data) noexcept
+  {
+    while (!data.empty())
+    {
+      if (!reserve(data.size()))
+        return;
+
+      const auto count = std::min(data.size(), m_map.size() - m_pos);
+      std::memcpy(m_map.data() + m_pos, data.data(), count);
+      m_pos += count;
+      data.remove_prefix(count);
+    }
+  }
+
+  void log_file::set_rotation(size_type maxSize, size_type maxFiles) noexcept
+  {
+    m_maxSize  = std::max(maxSize, m_segment);
+    m_maxFiles = maxFiles;
+  }
+
+  log_file::size_type log_file::size() const noexcept
+  {
+    return m_pos;
+  }
+
+  // Private members
+
+  bool log_file::reserve(size_type count) noexcept
+  {
+    if (!m_map)
+      return false;
+
+    if (m_pos && m_pos + count > m_maxSize && !rotate())
+      return false;
+
+    const auto mapped = m_map.size();
+    const auto required = m_pos + count;
+    if (required <= mapped)
+      return true;
+
+    // Messages larger than the limit are written in parts
+    if (mapped >= m_maxSize)
+      return m_pos < mapped;
+
+    auto newSize = mapped + m_segment;
+    while (newSize < required)
+    {
+      newSize += m_segment;
+    }
+
+    return m_map.resize(std::min(newSize, m_maxSize));
+  }
+
+  bool log_file::rotate() noexcept
+  {
+    m_map.close(m_pos);
+    m_pos = 0;
+
+    std::error_code err;
+    if (m_maxFiles)
+    {
+      fsys::remove(rotated_name(m_maxFiles), err);
+      for (auto idx = m_maxFiles; idx > 0; --idx)
+      {
+        fsys::rename(rotated_name(idx - 1), rotated_name(idx), err);
+      }
+    }
+
+    return m_map.open_write(m_name, m_segment);
+  }
+
+  log_file::name_type log_file::rotated_name(size_type idx) const noexcept
+  {
+    if (!idx)
+      return m_name;
+
+    auto res = m_name;
+    auto ext = m_name.extension();
+    res.replace_extension(std::to_string(idx));
+    res += ext;
+    return res;
+  }
+}
@@ -0,0 +1,306 @@
+#include "logger/recorder.hpp"
+#include "logger/category.hpp"
+#include "logger/buffer.hpp"
+
+#include <charconv>
+#include <csignal>
+
+namespace neko::logging
+{
+  namespace detail
+  {
+    //
+    // The recorder dumped on fatal signals
+    // Atomic, since handlers can run on any thread. It has to be lock-free
+    // to be used in a signal handler at all
+    //
+    std::atomic<recorder*> crashRecorder{};
+    static_assert(std::atomic<recorder*>::is_always_lock_free);
+
+    void on_fatal_signal(int sig) noexcept
+    {
+      if (auto rec = crashRecorder.exchange(nullptr))
+      {
+        rec->dump();
+      }
+
+      std::signal(sig, SIG_DFL);
+      std::raise(sig);
+    }
+
+    //
+    // Line buffer used while dumping
+    // Preallocated, since dumps might happen in signal handlers
+    //
+    constexpr auto lineSize = 1024ull;
+    std::array<char, lineSize> dumpLine{};
+
+    //
+    // Everything below formats records with std::to_chars and plain
+    // copies. Neither allocates, locks or looks at the locale
+    //
+
+    void put(bounded_out& out, std::string_view str) noexcept
+    {
+      for (auto c : str)
+      {
+        out = c;
+      }
+    }
+
+    template <typename T>
+    void put_chars(bounded_out& out, T val, int base = 10) noexcept
+    {
+      std::array<char, 32> buf{};
+      std::to_chars_result res{};
+      if constexpr (std::is_floating_point_v<T>)
+        res = std::to_chars(buf.data(), buf.data() + buf.size(), val);
+      else
+        res = std::to_chars(buf.data(), buf.data() + buf.size(), val, base);
+
+      if (res.ec == std::errc{})
+      {
+        put(out, { buf.data(), res.ptr });
+      }
+    }
+
+    //
+    // Writes an unsigned number padded with zeros to the specified width
+    //
+    void put_padded(bounded_out& out, std::uint64_t val, std::size_t width) noexcept
+    {
+      std::array<char, 20> buf{};
+      const auto res = std::to_chars(buf.data(), buf.data() + buf.size(), val);
+      const auto len = static_cast<std::size_t>(res.ptr - buf.data());
+      for (auto idx = len; idx < width; ++idx)
+      {
+        out = '0';
+      }
+      put(out, { buf.data(), len });
+    }
+
+    //
+    // Writes a time stamp in the same form the logger uses:
+    // 'YYYY-MM-DD, HH:MM:SS.uuuuuu'
+    //
+    void put_time(bounded_out& out, recorder::time_point tp, recorder::off_type offset) noexcept
+    {
+      namespace chr = std::chrono;
+      const auto local = chr::floor<chr::microseconds>(tp) + offset;
+      const auto day = chr::floor<chr::days>(local);
+      const chr::year_month_day ymd{ day };
+      const chr::hh_mm_ss hms{ local - day };
+
+      put_padded(out, static_cast<std::uint64_t>(static_cast<int>(ymd.year())), 4);
+      out = '-';
+      put_padded(out, static_cast<unsigned>(ymd.month()), 2);
+      out = '-';
+      put_padded(out, static_cast<unsigned>(ymd.day()), 2);
+      put(out, ", "sv);
+      put_padded(out, static_cast<std::uint64_t>(hms.hours().count()), 2);
+      out = ':';
+      put_padded(out, static_cast<std::uint64_t>(hms.minutes().count()), 2);
+      out = ':';
+      put_padded(out, static_cast<std::uint64_t>(hms.seconds().count()), 2);
+      out = '.';
+      put_padded(out, static_cast<std::uint64_t>(hms.subseconds().count()), 6);
+    }
+
+    //
+    // Writes a recorded argument in its default form
+    //
+    void put_arg(bounded_out& out, const recorder::record& rec, const recorder::arg& a) noexcept
+    {
+      using arg_type = recorder::arg;
+      switch (a.type)
+      {
+      case arg_type::boolean:
+        put(out, a.b ? "true"sv : "false"sv);
+        break;
+
+      case arg_type::character:
+        out = a.c;
+        break;
+
+      case arg_type::sint:
+        put_chars(out, a.i);
+        break;
+
+      case arg_type::uint:
+        put_chars(out, a.u);
+        break;
+
+      case arg_type::flt:
+        put_chars(out, a.f);
+        break;
+
+      case arg_type::dbl:
+        put_chars(out, a.d);
+        break;
+
+      case arg_type::ptr:
+        put(out, "0x"sv);
+        put_chars(out, reinterpret_cast<std::uintptr_t>(a.p), 16);
+        break;
+
+      case arg_type::str:
+        put(out, { rec.text.data() + a.offset, a.length });
+        break;
+
+      default:
+        break;
+      }
+    }
+
+    //
+    // Writes the message of a record, substituting replacement fields
+    // with recorded arguments
+    //
+    void put_message(bounded_out& out, const recorder::record& rec) noexcept
+    {
+      const auto fmt = std::string_view{ rec.text.data(), rec.fmtLen };
+      auto nextArg = std::size_t{};
+      for (auto it = fmt.begin(); it != fmt.end(); ++it)
+      {
+        const auto c = *it;
+        const auto next = std::next(it);
+        if ((c == '{' || c == '}') && next != fmt.end() && *next == c)
+        {
+          out = c;
+          it = next;
+          continue;
+        }
+
+        if (c != '{')
+        {
+          out = c;
+          continue;
+        }
+
+        const auto close = std::find(next, fmt.end(), '}');
+        if (close == fmt.end())
+        {
+          put(out, { it, fmt.end() });
+          break;
+        }
+
+        auto idx = nextArg++;
+        if (next != close && *next >= '0' && *next <= '9')
+        {
+          std::from_chars(std::to_address(next), std::to_address(close), idx);
+        }
+
+        if (idx < rec.argc)
+        {
+          put_arg(out, rec, rec.args[idx]);
+        }
+        it = close;
+      }
+    }
+
+    //
+    // Formats a single record into the dump line
+    // Returns the formatted part
+    //
+    std::string_view format_record(const recorder::record& rec, recorder::off_type offset) noexcept
+    {
+      auto&& buf = dumpLine;
+      const auto last = buf.data() + buf.size() - 1;
+      bounded_out out{ buf.data(), last };
+
+      put(out, "=="sv);
+      put_time(out, rec.time, offset);
+      put(out, "== ["sv);
+      put(out, to_string(static_cast<level>(rec.lvl)));
+      put(out, "] ("sv);
+      put(out, to_string(static_cast<category>(rec.cat)));
+      put(out, "): "sv);
+      put_message(out, rec);
+
+      if (rec.truncated)
+      {
+        put(out, "..."sv);
+      }
+
+      *out.cur++ = '\n';
+      return { buf.data(), out.cur };
+    }
+
+    //
+    // Looks up the offset of the local time from UTC in effect now
+    //
+    recorder::off_type zone_offset() noexcept
+    {
+      try
+      {
+        const auto now = std::chrono::floor<std::chrono::seconds>(recorder::clock_type::now());
+        return std::chrono::current_zone()->get_info(now).offset;
+      }
+      catch (std::exception&)
+      {
+        return {};
+      }
+    }
+  }
+
+  // Special members
+
+  recorder::recorder() noexcept = default;
+
+  // Public members
+
+  void recorder::dump(const file_name& fname) const noexcept
+  {
+    platform::raw_file file;
+    if (file.open(fname) && file.rewind())
+    {
+      write_to(file);
+    }
+  }
+  void recorder::dump() noexcept
+  {
+    if (m_crashFile.rewind())
+    {
+      write_to(m_crashFile);
+    }
+  }
+
+  void recorder::arm(const file_name& fname) noexcept
+  {
+    detail::crashRecorder.store(nullptr);
+    m_offset = detail::zone_offset();
+    if (!m_crashFile.open(fname))
+      return;
+
+    detail::crashRecorder.store(this);
+    for (auto sig : { SIGSEGV, SIGABRT, SIGFPE, SIGILL })
+    {
+      std::signal(sig, detail::on_fatal_signal);
+    }
+  }
+
+  recorder::size_type recorder::size() const noexcept
+  {
+    return std::min(m_next, capacity);
+  }
+
+  // Private members
+
+  void recorder::write_to(platform::raw_file& file) const noexcept
+  {
+    const auto count = size();
+    const auto first = m_next - count;
+    for (auto idx = first; idx < m_next; ++idx)
+    {
+      file.write(detail::format_record(m_ring[idx % capacity], m_offset));
+    }
+  }
+
+  recorder::size_type recorder::store_text(record& rec, str_type str) noexcept
+  {
+    const auto len = std::min(str.size(), textSize - rec.textLen);
+    std::memcpy(rec.text.data() + rec.textLen, str.data(), len);
+    rec.textLen += static_cast<len_type>(len);
+    return len;
+  }
+}
@@ -0,0 +1,128 @@
+#include "logger/stamp.hpp"
+
+namespace neko::logging
+{
+  // Special members
+
+  time_stamp::time_stamp() noexcept = default;
+
+  // Public members
+
+  void time_stamp::init() noexcept
+  {
+    try
+    {
+      m_zone = std::chrono::current_zone();
+    }
+    catch (std::runtime_error&)
+    {
+      m_zone = {};
+    }
+
+    m_sec = {};
+    m_prefixLen = 0;
+    m_offset = {};
+    m_infoBegin = {};
+    m_infoEnd = {};
+  }
+
+  time_stamp::precision time_stamp::set_precision(precision p) noexcept
+  {
+    const auto prev = m_precision;
+    m_precision = p;
+    return prev;
+  }
+
+  time_stamp::value_type time_stamp::get() noexcept
+  {
+    return get(clock_type::now());
+  }
+  time_stamp::value_type time_stamp::get(time_point tp) noexcept
+  {
+    const auto sec = std::chrono::floor<std::chrono::seconds>(tp);
+    if (sec != m_sec || !m_prefixLen)
+    {
+      refresh(sec);
+    }
+
+    append_fraction(tp, sec);
+    return { m_buf.data(), m_len };
+  }
+
+  // Private members
+
+  void time_stamp::refresh(sec_type sec) noexcept
+  {
+    namespace chr = std::chrono;
+    m_sec = sec;
+    if (m_zone && (sec < m_infoBegin || sec >= m_infoEnd))
+    {
+      update_offset(sec);
+    }
+
+    // Calendar fields are computed and formatted as plain integers,
+    // chrono formatters may go through streams and allocate
+    const auto local = sec + m_offset;
+    const auto day = chr::floor<chr::days>(local);
+    const chr::year_month_day ymd{ day };
+    const chr::hh_mm_ss hms{ local - day };
+
+    constexpr auto fmt = "{:04}-{:02}-{:02}, {:02}:{:02}:{:02}"sv;
+    try
+    {
+      auto res = std::format_to_n(m_buf.data(), m_buf.size(), fmt,
+                                  static_cast<int>(ymd.year()),
+                                  static_cast<unsigned>(ymd.month()),
+                                  static_cast<unsigned>(ymd.day()),
+                                  hms.hours().count(),
+                                  hms.minutes().count(),
+                                  hms.seconds().count());
+      m_prefixLen = static_cast<size_type>(res.out - m_buf.data());
+    }
+    catch (std::exception&)
+    {
+      m_prefixLen = 0;
+    }
+  }
+
+  void time_stamp::update_offset(sec_type sec) noexcept
+  {
+    try
+    {
+      const auto info = m_zone->get_info(sec);
+      m_offset    = info.offset;
+      m_infoBegin = info.begin;
+      m_infoEnd   = info.end;
+    }
+    catch (std::exception&)
+    {
+      m_offset    = {};
+      m_infoBegin = sec_type::min();
+      m_infoEnd   = sec_type::max();
+    }
+  }
+
+  void time_stamp::append_fraction(time_point tp, sec_type sec) noexcept
+  {
+    m_len = m_prefixLen;
+    const auto digits = static_cast<size_type>(m_precision);
+    if (!digits || m_len + digits + 1 > m_buf.size())
+      return;
+
+    using micro_type = std::chrono::microseconds;
+    auto frac = std::chrono::duration_cast<micro_type>(tp - sec).count();
+    for (auto i = digits; i < static_cast<size_type>(micro); ++i)
+    {
+      frac /= 10;
+    }
+
+    m_buf[m_len] = '.';
+    for (auto pos = m_len + digits; pos > m_len; --pos)
+    {
+      m_buf[pos] = static_cast<char>('0' + frac % 10);
+      frac /= 10;
+    }
+
+    m_len += digits + 1;
+  }
+}
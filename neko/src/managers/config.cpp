@@ -3,6 +3,98 @@
 
 namespace neko
 {
+  namespace detail
+  {
+    //
+    // Calls a function for each index in [0, count) on a pool of threads
+    // The calling thread takes part as well and returns when all
+    // indices are processed
+    //
+    template <typename Fn>
+    void parallel_for(std::size_t count, Fn&& fn) noexcept
+    {
+      if (!count)
+        return;
+
+      std::atomic_size_t next{};
+      auto work = [&next, &fn, count]() noexcept
+        {
+          for (auto idx = next++; idx < count; idx = next++)
+            fn(idx);
+        };
+
+      const auto cores = std::max(std::thread::hardware_concurrency(), 1u);
+      const auto threadCount = std::min<std::size_t>(cores, count);
+      std::vector<std::jthread> pool;
+      try
+      {
+        pool.reserve(threadCount - 1);
+        for (auto idx = 1ull; idx < threadCount; ++idx)
+          pool.emplace_back(work);
+      }
+      catch (std::exception&)
+      {
+        // Fewer threads, the rest of the work is done by those running
+      }
+
+      work();
+    }
+
+    //
+    // How often the worker checks whether it should stop
+    //
+    constexpr auto watchTimeout = std::chrono::milliseconds{ 250 };
+
+    bool same(const config::option& l, const config::option& r) noexcept
+    {
+      return l.name() == r.name()
+          && std::equal(l.begin(), l.end(), r.begin(), r.end());
+    }
+
+    bool same(const config::section& l, const config::section& r) noexcept
+    {
+      const auto lOpts = l.options();
+      const auto rOpts = r.options();
+      const auto lSecs = l.sections();
+      const auto rSecs = r.sections();
+      return l.name() == r.name()
+          && std::equal(lOpts.begin(), lOpts.end(), rOpts.begin(), rOpts.end(),
+                        [](auto lo, auto ro) noexcept { return same(*lo, *ro); })
+          && std::equal(lSecs.begin(), lSecs.end(), rSecs.begin(), rSecs.end(),
+                        [](auto ls, auto rs) noexcept { return same(*ls, *rs); });
+    }
+
+    //
+    // Lists top-level sections which differ between two trees
+    // Changes in options of the root are reported by the root's name
+    //
+    evt::config_changed::section_list diff(const config::section& from, const config::section& to)
+    {
+      evt::config_changed::section_list res;
+      const auto fromOpts = from.options();
+      const auto toOpts   = to.options();
+      if (!std::equal(fromOpts.begin(), fromOpts.end(), toOpts.begin(), toOpts.end(),
+                      [](auto lo, auto ro) noexcept { return same(*lo, *ro); }))
+      {
+        res.emplace_back(to.name());
+      }
+
+      for (auto sec : from.sections())
+      {
+        auto other = to.get_section(sec->name());
+        if (!other || !same(*sec, *other))
+          res.emplace_back(sec->name());
+      }
+      for (auto sec : to.sections())
+      {
+        if (!from.get_section(sec->name()))
+          res.emplace_back(sec->name());
+      }
+
+      return res;
+    }
+  }
+
   // Special members
 
   conf_manager::~conf_manager() noexcept = default;
@@ -13,11 +105,11 @@ namespace neko
     m_root = fsys::absolute(root, err);
     if (err)
     {
-      logger::error("Path {} is invalid. {}", root.string(), err.message());
+      NEK_LOG(config, err, "Path {} is invalid. {}", root.string(), err.message());
       return;
     }
 
-    logger::note("Root path for configuration files: {}", m_root.string());
+    NEK_LOG(config, msg, "Root path for configuration files: {}", m_root.string());
   }
 
   const conf_manager::cfg_type* conf_manager::operator[](key_type key) const noexcept
@@ -29,34 +121,68 @@ namespace neko
 
   bool conf_manager::load_file(key_type key, path_type fname) noexcept
   {
-    fname = canonise(std::move(fname));
-    if (fname.empty())
+    const load_item item{ key, std::move(fname) };
+    const auto report = load_files({ &item, 1 });
+    return !report.empty() && utils::eq_any(report.front(), load_result::loaded, load_result::present);
+  }
+
+  conf_manager::load_report conf_manager::load_files(load_batch files) noexcept
+  {
+    const auto count = files.size();
+    load_report report;
+    std::vector<path_type> paths;
+    std::vector<res_opt<cfg_type>> loaded;
+    std::vector<std::uint8_t> toParse;
+    try
     {
-      return false;
+      report.resize(count, load_result::failed);
+      paths.resize(count);
+      loaded.resize(count);
+      toParse.resize(count);
     }
+    catch (std::bad_alloc&)
+    {
+      NEK_LOG(config, err, "Not enough memory to load {} config files", count);
+      return {};
+    }
+
+    detail::parallel_for(count, [&](std::size_t idx) noexcept
+      {
+        paths[idx] = canonise(files[idx].second);
+        if (paths[idx].empty())
+          report[idx] = load_result::bad_path;
+      });
 
-    NEK_TRACE("Opening config file {}", fname.string());
-    auto foundKey = lookup_index(fname);
-    if (foundKey)
+    // Each file is parsed once no matter how many times it's listed,
+    // and files which are loaded already aren't parsed at all
+    try
     {
-      if (*foundKey != key)
+      std::unordered_set<path_type, path_hasher> seen;
+      for (auto idx = 0ull; idx < count; ++idx)
       {
-        logger::warning("Path {} is already mapped to a different name", fname.string());
-        return false; 
+        auto&& path = paths[idx];
+        toParse[idx] = !path.empty() && !lookup_index(path) && seen.insert(path).second;
       }
-
-      return true;
     }
-
-    auto&& [newItem, ok] = m_storage.emplace(key, cfg_type{fname});
-    if (!ok || !static_cast<bool>(newItem->second))
+    catch (std::bad_alloc&)
     {
-      logger::error("Unable to open file {}", fname.string());
-      return false;
+      NEK_LOG(config, err, "Not enough memory to load {} config files", count);
+      return {};
     }
 
-    m_index.emplace(std::move(fname), key);
-    return true;
+    detail::parallel_for(count, [&](std::size_t idx) noexcept
+      {
+        if (!toParse[idx])
+          return;
+
+        // Loaded files are watched, and might be saved over while
+        // the tree is in use, so the tree is built from a copy
+        NEK_TRACE_IN(config, "Opening config file {}", paths[idx].string());
+        loaded[idx].emplace(paths[idx], cfg_type::cache_policy::cached, cfg_type::storage::owned);
+      });
+
+    register_batch(files, paths, loaded, report);
+    return report;
   }
 
   bool conf_manager::exists(key_type key) const noexcept
@@ -67,7 +193,99 @@ namespace neko
   const conf_manager::cfg_type* conf_manager::lookup(key_type key) const noexcept
   {
     auto item = m_storage.find(key);
-    return item != m_storage.end() ? &item->second : nullptr;
+    return item != m_storage.end() ? item->second.get() : nullptr;
+  }
+
+  conf_manager::snapshot conf_manager::acquire(key_type key) const noexcept
+  {
+    const auto registry = m_published.load(std::memory_order_acquire);
+    if (!registry)
+      return {};
+
+    auto item = registry->find(key);
+    return item != registry->end() ? item->second : snapshot{};
+  }
+
+  void conf_manager::update() noexcept
+  {
+    if (!m_hasReloaded.load(std::memory_order_acquire))
+      return;
+
+    reload_list reloaded;
+    {
+      std::lock_guard lock{ m_reloadLock };
+      reloaded.swap(m_reloaded);
+      m_hasReloaded.store(false, std::memory_order_relaxed);
+    }
+
+    for (auto&& [path, conf] : reloaded)
+    {
+      swap_in(path, std::move(conf));
+    }
+
+    publish();
+    event<change_evt>::dispatch();
+  }
+
+  conf_manager::include_span conf_manager::includes(const config::section& sec) noexcept
+  {
+    if (auto cached = m_included.find(&sec); cached != m_included.end())
+      return cached->second;
+
+    auto opt = sec.get_option(includeOption);
+    if (!opt)
+      return {};
+
+    std::vector<load_item> batch;
+    std::vector<path_type> paths;
+    include_list res;
+    try
+    {
+      for (auto&& val : *opt)
+      {
+        auto name = val.try_get<config::value::str_val>();
+        if (!name)
+        {
+          NEK_LOG(config, warn, "Section {} has an include which is not a path", sec.name());
+          continue;
+        }
+
+        auto path = canonise(*name);
+        if (path.empty())
+          continue;
+
+        // The same file might be listed more than once, written differently
+        if (std::find(paths.begin(), paths.end(), path) != paths.end())
+          continue;
+
+        // Already loaded files are shared, the rest are loaded together
+        if (!lookup_index(path))
+          batch.emplace_back(include_key(*name), path);
+
+        paths.emplace_back(std::move(path));
+      }
+
+      load_files(batch);
+      for (auto&& path : paths)
+      {
+        auto key = lookup_index(path);
+        auto conf = key ? lookup(*key) : nullptr;
+        if (!conf)
+        {
+          NEK_LOG(config, warn, "Unable to include config file {}", path.string());
+          continue;
+        }
+
+        res.push_back(conf);
+      }
+
+      return m_included.emplace(&sec, std::move(res)).first->second;
+    }
+    catch (std::bad_alloc&)
+    {
+      NEK_LOG(config, err, "Not enough memory to include files in section {}", sec.name());
+      return {};
+    }
   }
 
   // Private members
@@ -91,9 +309,191 @@ namespace neko
     path = fsys::canonical(fullPath, err);
     if (err)
     {
-      logger::warning("Unable to open config file {}. {}", fullPath.string(), err.message());
+      NEK_LOG(config, warn, "Unable to open config file {}. {}", fullPath.string(), err.message());
     }
     
     return path;
   }
+
+  void conf_manager::register_batch(load_batch files, std::span<const path_type> paths,
+                                    std::span<res_opt<cfg_type>> loaded, load_report& report) noexcept
+  {
+    const auto count = files.size();
+    std::vector<std::size_t> added;
+    try
+    {
+      added.reserve(count);
+      m_storage.reserve(m_storage.size() + count);
+      m_index.reserve(m_index.size() + count);
+
+      for (auto idx = 0ull; idx < count; ++idx)
+      {
+        if (report[idx] == load_result::bad_path)
+          continue;
+
+        const auto key = files[idx].first;
+        auto&& path = paths[idx];
+        if (auto foundKey = lookup_index(path))
+        {
+          if (*foundKey == key)
+          {
+            report[idx] = load_result::present;
+            continue;
+          }
+
+          NEK_LOG(config, warn, "Path {} is already mapped to a different name", path.string());
+          report[idx] = load_result::path_taken;
+          continue;
+        }
+
+        auto&& conf = loaded[idx];
+        if (!conf || !static_cast<bool>(*conf))
+        {
+          NEK_LOG(config, err, "Unable to open file {}", path.string());
+          report[idx] = load_result::failed;
+          continue;
+        }
+
+        if (exists(key))
+        {
+          NEK_LOG(config, warn, "Name for {} is already used by a different file", path.string());
+          report[idx] = load_result::key_taken;
+          continue;
+        }
+
+        // Recorded as soon as it's stored, so that the rollback catches
+        // it even if adding the index entry throws. The room is reserved
+        m_storage.emplace(key, snapshot{ std::make_shared<const cfg_type>(std::move(*conf)), 1 });
+        added.push_back(idx);
+        m_index.emplace(path, key);
+        report[idx] = load_result::loaded;
+      }
+    }
+    catch (std::bad_alloc&)
+    {
+      NEK_LOG(config, err, "Not enough memory to register {} config files", count);
+      // The last file might not have its index entry, erase is fine
+      // with that
+      for (auto idx : added)
+      {
+        m_storage.erase(files[idx].first);
+        m_index.erase(paths[idx]);
+        report[idx] = load_result::failed;
+      }
+      return;
+    }
+
+    if (!added.empty())
+      publish();
+
+    for (auto idx : added)
+    {
+      watch(paths[idx]);
+    }
+  }
+
+  void conf_manager::watch(const path_type& path) noexcept
+  {
+    if (!m_watch.add(path))
+    {
+      NEK_LOG(config, warn, "Changes to {} won't be picked up", path.string());
+      return;
+    }
+
+    if (m_worker.joinable())
+      return;
+
+    try
+    {
+      m_worker = std::jthread{ [this](std::stop_token stop) noexcept { watch_proc(stop); } };
+    }
+    catch (std::system_error& e)
+    {
+      NEK_LOG(config, warn, "Unable to start the config watcher. {}", e.what());
+    }
+  }
+
+  void conf_manager::watch_proc(std::stop_token stop) noexcept
+  {
+    platform::file_watch::name_list changed;
+    while (!stop.stop_requested())
+    {
+      changed.clear();
+      if (!m_watch.wait(changed, detail::watchTimeout))
+      {
+        NEK_LOG(config, warn, "Config file watch failed, changes won't be picked up");
+        return;
+      }
+
+      for (auto&& path : changed)
+      {
+        NEK_LOG(config, msg, "Reloading config file {}", path.string());
+        cfg_type conf{ path, cfg_type::cache_policy::cached, cfg_type::storage::owned };
+        if (!conf)
+        {
+          NEK_LOG(config, warn, "Unable to reload config file {}, keeping the old one", path.string());
+          continue;
+        }
+
+        try
+        {
+          std::lock_guard lock{ m_reloadLock };
+          m_reloaded.emplace_back(path, std::move(conf));
+          m_hasReloaded.store(true, std::memory_order_release);
+        }
+        catch (std::bad_alloc&)
+        {
+          NEK_LOG(config, warn, "Unable to reload config file {}, keeping the old one", path.string());
+        }
+      }
+    }
+  }
+
+  void conf_manager::swap_in(const path_type& path, cfg_type&& conf) noexcept
+  {
+    auto key = lookup_index(path);
+    if (!key)
+      return;
+
+    auto item = m_storage.find(*key);
+    if (item == m_storage.end())
+      return;
+
+    try
+    {
+      auto&& old = item->second;
+      auto sections = detail::diff(**old, *conf);
+      const auto version = old.version() + 1;
+
+      // The old version stays alive along with its arena as long as
+      // there are snapshots of it
+      old = snapshot{ std::make_shared<const cfg_type>(std::move(conf)), version };
+
+      // Includes refer to the old trees
+      m_included.clear();
+      event<change_evt>::push(*key, path, std::move(sections), version);
+    }
+    catch (std::bad_alloc&)
+    {
+      NEK_LOG(config, warn, "Unable to swap in reloaded config file {}", path.string());
+    }
+  }
+
+  void conf_manager::publish() noexcept
+  {
+    try
+    {
+      m_published.store(std::make_shared<const store_type>(m_storage), std::memory_order_release);
+    }
+    catch (std::bad_alloc&)
+    {
+      NEK_LOG(config, err, "Not enough memory to publish configs, other threads will see older versions");
+    }
+  }
+
+  conf_manager::key_type conf_manager::include_key(const path_type& path)
+  {
+    auto&& name = *m_includeNames.emplace(path.lexically_normal().generic_string()).first;
+    return key_type{ name.data(), name.size() };
+  }
 }
\ No newline at end of file
@@ -19,19 +19,19 @@ namespace neko
   void input::on_button(const btn_event& e) noexcept
   {
     utils::unused(e);
-    NEK_TRACE("Device index {}: '0x{:02X}' ({}) key {}", e.device, e.to_char(),
-               e.to_string(), (e.is_up() ? "released"sv : "pressed"sv));
+    NEK_TRACE_IN(input, "Device index {}: '0x{:02X}' ({}) key {}", e.device, e.to_char(),
+                        e.to_string(), (e.is_up() ? "released"sv : "pressed"sv));
   }
 
   void input::on_position(const position_event& e) noexcept
   {
     utils::unused(e);
-    NEK_TRACE("{} {} at [{:5.4f}: {:5.4f}]", e.to_string(), e.device, e.horizontal, e.vertical);
+    NEK_TRACE_IN(input, "{} {} at [{:5.4f}: {:5.4f}]", e.to_string(), e.device, e.horizontal, e.vertical);
   }
 
   void input::on_axis(const axis_event& e) noexcept
   {
     utils::unused(e);
-    NEK_TRACE("{} {} at {:5.4f}", e.to_string(), e.device, e.delta);
+    NEK_TRACE_IN(input, "{} {} at {:5.4f}", e.to_string(), e.device, e.delta);
   }
 }
\ No newline at end of file
@@ -13,13 +13,13 @@ namespace neko
 
   renderer::~renderer() noexcept
   {
-    logger::note("Shutting down rendering pipeline");
+    NEK_LOG(render, msg, "Shutting down rendering pipeline");
     m_pipeline.reset();
   }
 
   renderer::renderer(const host_info& info) noexcept
   {
-    logger::note("Initialising rendering pipeline");
+    NEK_LOG(render, msg, "Initialising rendering pipeline");
     init_pipeline(info);
   }
 
@@ -0,0 +1,77 @@
+#include "platform/file_map.hpp"
+
+namespace neko::platform
+{
+  // Special members
+
+  file_map::file_map(file_map&& other) noexcept
+  {
+    swap(other);
+  }
+  file_map& file_map::operator=(file_map&& other) noexcept
+  {
+    if (this != &other)
+    {
+      close();
+      swap(other);
+    }
+    return *this;
+  }
+
+  file_map::~file_map() noexcept
+  {
+    close();
+  }
+
+  file_map::file_map() noexcept = default;
+
+  file_map::operator bool() const noexcept
+  {
+    return static_cast<bool>(m_data);
+  }
+
+  // Public members
+
+  void file_map::close(size_type used) noexcept
+  {
+    release(used);
+    m_data = nullptr;
+    m_size = 0;
+    m_file = -1;
+    m_mapping = -1;
+  }
+  void file_map::close() noexcept
+  {
+    close(m_size);
+  }
+
+  const file_map::value_type* file_map::data() const noexcept
+  {
+    return m_data;
+  }
+  file_map::value_type* file_map::data() noexcept
+  {
+    NEK_ASSERT(writable());
+    return m_data;
+  }
+
+  file_map::size_type file_map::size() const noexcept
+  {
+    return m_size;
+  }
+
+  bool file_map::writable() const noexcept
+  {
+    return m_file != -1;
+  }
+
+  // Private members
+
+  void file_map::swap(file_map& other) noexcept
+  {
+    std::swap(m_data, other.m_data);
+    std::swap(m_size, other.m_size);
+    std::swap(m_file, other.m_file);
+    std::swap(m_mapping, other.m_mapping);
+  }
+}
@@ -0,0 +1,42 @@
+#include "platform/file_watch.hpp"
+
+namespace neko::platform
+{
+  // Private members
+
+  const file_watch::dir_entry* file_watch::find_dir(const name_type& path) const noexcept
+  {
+    auto it = std::find_if(m_dirs.begin(), m_dirs.end(), [&path](const auto& dir) noexcept
+      {
+        return dir.path == path;
+      });
+
+    return it != m_dirs.end() ? &*it : nullptr;
+  }
+
+  void file_watch::collect(const name_type& dir, name_list& changed) noexcept
+  {
+    std::error_code err;
+    for (auto&& [name, stamp] : m_files)
+    {
+      if (name.parent_path() != dir)
+        continue;
+
+      // A file being replaced might be missing for a moment,
+      // it'll be picked up by the notification which follows
+      const auto cur = fsys::last_write_time(name, err);
+      if (err || cur == stamp)
+        continue;
+
+      try
+      {
+        changed.push_back(name);
+        stamp = cur;
+      }
+      catch (std::bad_alloc&)
+      {
+        return;
+      }
+    }
+  }
+}
@@ -0,0 +1,32 @@
+#include "platform/console.hpp"
+
+#if NEK_POSIX
+
+#include "platform/support/posix/posix_includes.hpp"
+
+#include <cerrno>
+
+namespace neko::platform
+{
+  void console_write(std::string_view str) noexcept
+  {
+    auto cur  = str.data();
+    auto left = str.size();
+    while (left)
+    {
+      const auto written = ::write(STDOUT_FILENO, cur, left);
+      if (written < 0)
+      {
+        if (errno == EINTR)
+          continue;
+
+        return;
+      }
+
+      cur  += written;
+      left -= static_cast<std::size_t>(written);
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,108 @@
+#include "platform/file_map.hpp"
+
+#if NEK_POSIX
+
+#include "platform/support/posix/posix_includes.hpp"
+
+namespace neko::platform
+{
+  namespace detail
+  {
+    void* map_fd(int fd, std::size_t size, bool write) noexcept
+    {
+      const auto prot  = write ? PROT_READ | PROT_WRITE : PROT_READ;
+      const auto flags = write ? MAP_SHARED : MAP_PRIVATE;
+      auto ptr = ::mmap(nullptr, size, prot, flags, fd, 0);
+      return ptr != MAP_FAILED ? ptr : nullptr;
+    }
+  }
+
+  // Public members
+
+  bool file_map::open_read(const name_type& fname) noexcept
+  {
+    close();
+    const auto fd = ::open(fname.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd == -1)
+      return false;
+
+    struct stat st{};
+    if (::fstat(fd, &st) || !S_ISREG(st.st_mode) || st.st_size <= 0)
+    {
+      ::close(fd);
+      return false;
+    }
+
+    const auto size = static_cast<size_type>(st.st_size);
+    auto ptr = detail::map_fd(fd, size, false);
+    ::close(fd);
+    if (!ptr)
+      return false;
+
+    m_data = static_cast<value_type*>(ptr);
+    m_size = size;
+    return true;
+  }
+
+  bool file_map::open_write(const name_type& fname, size_type size) noexcept
+  {
+    close();
+    const auto fd = ::open(fname.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd == -1)
+      return false;
+
+    m_file = fd;
+    if (!resize(size))
+    {
+      close(0);
+      return false;
+    }
+
+    return true;
+  }
+
+  bool file_map::resize(size_type size) noexcept
+  {
+    NEK_ASSERT(writable());
+    const auto fd = static_cast<int>(m_file);
+    if (::ftruncate(fd, static_cast<off_t>(size)))
+      return false;
+
+    // The old view is only dropped once the new one exists, so that
+    // a failure leaves the mapping as it was
+    auto ptr = detail::map_fd(fd, size, true);
+    if (!ptr)
+      return false;
+
+    if (m_data)
+    {
+      ::munmap(m_data, m_size);
+    }
+
+    m_data = static_cast<value_type*>(ptr);
+    m_size = size;
+    return true;
+  }
+
+  // Private members
+
+  void file_map::release(size_type used) noexcept
+  {
+    if (m_data)
+    {
+      ::munmap(m_data, m_size);
+    }
+
+    if (writable())
+    {
+      const auto fd = static_cast<int>(m_file);
+      if (::ftruncate(fd, static_cast<off_t>(used)))
+      {
+        // Nothing to be done here, the file is just a bit longer
+      }
+      ::close(fd);
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,143 @@
+#include "platform/file_watch.hpp"
+
+#if NEK_POSIX
+
+#include "platform/support/posix/posix_includes.hpp"
+
+#if NEK_LINUX
+  #include <sys/inotify.h>
+  #include <poll.h>
+  #include <cerrno>
+#endif
+
+namespace neko::platform
+{
+#if NEK_LINUX
+
+  namespace detail
+  {
+    constexpr auto watchMask = IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE;
+  }
+
+  // Special members
+
+  file_watch::~file_watch() noexcept
+  {
+    if (*this)
+    {
+      ::close(static_cast<int>(m_handle));
+    }
+  }
+
+  file_watch::file_watch() noexcept :
+    m_handle{ ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC) }
+  { }
+
+  file_watch::operator bool() const noexcept
+  {
+    return m_handle != -1;
+  }
+
+  // Public members
+
+  bool file_watch::add(const name_type& fname) noexcept
+  {
+    if (!*this)
+      return false;
+
+    std::error_code err;
+    const auto stamp = fsys::last_write_time(fname, err);
+    if (err)
+      return false;
+
+    std::lock_guard lock{ m_lock };
+    try
+    {
+      auto dir = fname.parent_path();
+      if (!find_dir(dir))
+      {
+        m_dirs.reserve(m_dirs.size() + 1);
+        const auto wd = ::inotify_add_watch(static_cast<int>(m_handle), dir.c_str(), detail::watchMask);
+        if (wd == -1)
+          return false;
+
+        m_dirs.push_back({ wd, std::move(dir) });
+      }
+
+      m_files.insert_or_assign(fname, stamp);
+    }
+    catch (std::bad_alloc&)
+    {
+      return false;
+    }
+
+    return true;
+  }
+
+  bool file_watch::wait(name_list& changed, time_type timeout) noexcept
+  {
+    if (!*this)
+      return false;
+
+    const auto fd = static_cast<int>(m_handle);
+    ::pollfd pfd{ fd, POLLIN, 0 };
+    const auto ready = ::poll(&pfd, 1, static_cast<int>(timeout.count()));
+    if (ready <= 0)
+      return !ready || errno == EINTR;
+
+    // Events only tell which directories to rescan. Editors produce
+    // several of them per save, write times filter out the repeats
+    alignas(::inotify_event) std::array<char, 4096> buf;
+    std::lock_guard lock{ m_lock };
+    for (;;)
+    {
+      const auto len = ::read(fd, buf.data(), buf.size());
+      if (len <= 0)
+        break;
+
+      for (auto cur = buf.data(); cur < buf.data() + len; )
+      {
+        ::inotify_event evt;
+        std::memcpy(&evt, cur, sizeof(evt));
+        cur += sizeof(evt) + evt.len;
+
+        for (auto&& dir : m_dirs)
+        {
+          if ((evt.mask & IN_Q_OVERFLOW) || dir.handle == evt.wd)
+            collect(dir.path, changed);
+        }
+      }
+    }
+
+    return true;
+  }
+
+#else
+
+  // Special members
+
+  file_watch::~file_watch() noexcept = default;
+
+  file_watch::file_watch() noexcept = default;
+
+  file_watch::operator bool() const noexcept
+  {
+    return false;
+  }
+
+  // Public members
+
+  bool file_watch::add(const name_type&) noexcept
+  {
+    return false;
+  }
+
+  bool file_watch::wait(name_list&, time_type) noexcept
+  {
+    return false;
+  }
+
+#endif
+}
+
+#endif
@@ -0,0 +1,72 @@
+#include "platform/raw_file.hpp"
+
+#if NEK_POSIX
+
+#include "platform/support/posix/posix_includes.hpp"
+
+#include <cerrno>
+
+namespace neko::platform
+{
+  // Public members
+
+  bool raw_file::open(const name_type& fname) noexcept
+  {
+    close();
+    const auto fd = ::open(fname.c_str(), O_WRONLY | O_CREAT | O_CLOEXEC, 0644);
+    if (fd == -1)
+      return false;
+
+    m_file = fd;
+    return true;
+  }
+
+  bool raw_file::rewind() noexcept
+  {
+    if (m_file == -1)
+      return false;
+
+    const auto fd = static_cast<int>(m_file);
+    return !::ftruncate(fd, 0) && ::lseek(fd, 0, SEEK_SET) == 0;
+  }
+
+  bool raw_file::write(value_type str) noexcept
+  {
+    if (m_file == -1)
+      return false;
+
+    const auto fd = static_cast<int>(m_file);
+    auto cur  = str.data();
+    auto left = str.size();
+    while (left)
+    {
+      const auto written = ::write(fd, cur, left);
+      if (written < 0)
+      {
+        if (errno == EINTR)
+          continue;
+
+        return false;
+      }
+
+      cur  += written;
+      left -= static_cast<std::size_t>(written);
+    }
+
+    return true;
+  }
+
+  bool raw_file::sync() noexcept
+  {
+    return m_file != -1 && !::fsync(static_cast<int>(m_file));
+  }
+
+  // Private members
+
+  void raw_file::release() noexcept
+  {
+    ::close(static_cast<int>(m_file));
+  }
+}
+
+#endif
@@ -0,0 +1,29 @@
+#include "platform/raw_file.hpp"
+
+namespace neko::platform
+{
+  // Special members
+
+  raw_file::~raw_file() noexcept
+  {
+    close();
+  }
+
+  raw_file::raw_file() noexcept = default;
+
+  raw_file::operator bool() const noexcept
+  {
+    return m_file != -1;
+  }
+
+  // Public members
+
+  void raw_file::close() noexcept
+  {
+    if (m_file != -1)
+    {
+      release();
+    }
+    m_file = -1;
+  }
+}
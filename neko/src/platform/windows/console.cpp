@@ -0,0 +1,31 @@
+#include "platform/console.hpp"
+
+#if NEK_WINDOWS
+
+#include "platform/support/windows/win_includes.hpp"
+
+namespace neko::platform
+{
+  void console_write(std::string_view str) noexcept
+  {
+    auto out = GetStdHandle(STD_OUTPUT_HANDLE);
+    if (!out || out == INVALID_HANDLE_VALUE)
+      return;
+
+    auto cur  = str.data();
+    auto left = str.size();
+    while (left)
+    {
+      constexpr auto chunkMax = std::size_t{ MAXDWORD };
+      const auto chunk = static_cast<DWORD>(std::min(left, chunkMax));
+      DWORD written{};
+      if (!WriteFile(out, cur, chunk, &written, nullptr) || !written)
+        return;
+
+      cur  += written;
+      left -= written;
+    }
+  }
+}
+
+#endif
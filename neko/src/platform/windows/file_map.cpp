@@ -0,0 +1,142 @@
+#include "platform/file_map.hpp"
+
+#if NEK_WINDOWS
+
+#include "platform/support/windows/win_includes.hpp"
+
+namespace neko::platform
+{
+  namespace detail
+  {
+    auto to_handle(file_map::handle_type h) noexcept
+    {
+      return reinterpret_cast<HANDLE>(h);
+    }
+    auto from_handle(HANDLE h) noexcept
+    {
+      return reinterpret_cast<file_map::handle_type>(h);
+    }
+
+    HANDLE make_mapping(HANDLE file, std::size_t size, bool write) noexcept
+    {
+      const auto prot = write ? PAGE_READWRITE : PAGE_READONLY;
+      const auto sz = static_cast<std::uint64_t>(size);
+      return CreateFileMappingW(file, nullptr, prot,
+                                static_cast<DWORD>(sz >> 32),
+                                static_cast<DWORD>(sz & 0xFFFFFFFFull),
+                                nullptr);
+    }
+  }
+
+  // Public members
+
+  bool file_map::open_read(const name_type& fname) noexcept
+  {
+    close();
+    // Sharing delete access lets the file be saved over (see cfg_writer)
+    // while it's mapped
+    auto file = CreateFileW(fname.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                            nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+      return false;
+
+    LARGE_INTEGER fsize{};
+    if (GetFileType(file) != FILE_TYPE_DISK || !GetFileSizeEx(file, &fsize) || fsize.QuadPart <= 0)
+    {
+      CloseHandle(file);
+      return false;
+    }
+
+    const auto size = static_cast<size_type>(fsize.QuadPart);
+    auto mapping = detail::make_mapping(file, size, false);
+    CloseHandle(file);
+    if (!mapping)
+      return false;
+
+    auto ptr = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, size);
+    CloseHandle(mapping);
+    if (!ptr)
+      return false;
+
+    m_data = static_cast<value_type*>(ptr);
+    m_size = size;
+    return true;
+  }
+
+  bool file_map::open_write(const name_type& fname, size_type size) noexcept
+  {
+    close();
+    auto file = CreateFileW(fname.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ,
+                            nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+      return false;
+
+    m_file = detail::from_handle(file);
+    if (!resize(size))
+    {
+      close(0);
+      return false;
+    }
+
+    return true;
+  }
+
+  bool file_map::resize(size_type size) noexcept
+  {
+    NEK_ASSERT(writable());
+    // The old view is only dropped once the new one exists, so that
+    // a failure leaves the mapping as it was
+    auto mapping = detail::make_mapping(detail::to_handle(m_file), size, true);
+    if (!mapping)
+      return false;
+
+    auto ptr = MapViewOfFile(mapping, FILE_MAP_WRITE, 0, 0, size);
+    if (!ptr)
+    {
+      CloseHandle(mapping);
+      return false;
+    }
+
+    if (m_data)
+    {
+      UnmapViewOfFile(m_data);
+    }
+    if (m_mapping != -1)
+    {
+      CloseHandle(detail::to_handle(m_mapping));
+    }
+
+    m_mapping = detail::from_handle(mapping);
+    m_data = static_cast<value_type*>(ptr);
+    m_size = size;
+    return true;
+  }
+
+  // Private members
+
+  void file_map::release(size_type used) noexcept
+  {
+    if (m_data)
+    {
+      UnmapViewOfFile(m_data);
+    }
+    if (m_mapping != -1)
+    {
+      CloseHandle(detail::to_handle(m_mapping));
+    }
+
+    if (writable())
+    {
+      auto file = detail::to_handle(m_file);
+      LARGE_INTEGER pos{};
+      pos.QuadPart = static_cast<LONGLONG>(used);
+      if (SetFilePointerEx(file, pos, nullptr, FILE_BEGIN))
+      {
+        SetEndOfFile(file);
+      }
+      CloseHandle(file);
+    }
+  }
+}
+
+#endif
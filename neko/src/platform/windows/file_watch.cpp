@@ -0,0 +1,107 @@
+#include "platform/file_watch.hpp"
+
+#if NEK_WINDOWS
+
+#include "platform/support/windows/win_includes.hpp"
+
+namespace neko::platform
+{
+  namespace detail
+  {
+    constexpr auto watchFilter = FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_FILE_NAME;
+
+    auto to_handle(file_watch::handle_type h) noexcept
+    {
+      return reinterpret_cast<HANDLE>(h);
+    }
+  }
+
+  // Special members
+
+  file_watch::~file_watch() noexcept
+  {
+    for (auto&& dir : m_dirs)
+    {
+      FindCloseChangeNotification(detail::to_handle(dir.handle));
+    }
+  }
+
+  file_watch::file_watch() noexcept = default;
+
+  file_watch::operator bool() const noexcept
+  {
+    // Directories have their own notification handles
+    return true;
+  }
+
+  // Public members
+
+  bool file_watch::add(const name_type& fname) noexcept
+  {
+    std::error_code err;
+    const auto stamp = fsys::last_write_time(fname, err);
+    if (err)
+      return false;
+
+    std::lock_guard lock{ m_lock };
+    try
+    {
+      auto dir = fname.parent_path();
+      if (!find_dir(dir))
+      {
+        if (m_dirs.size() == MAXIMUM_WAIT_OBJECTS)
+          return false;
+
+        m_dirs.reserve(m_dirs.size() + 1);
+        auto handle = FindFirstChangeNotificationW(dir.c_str(), FALSE, detail::watchFilter);
+        if (handle == INVALID_HANDLE_VALUE)
+          return false;
+
+        m_dirs.push_back({ reinterpret_cast<handle_type>(handle), std::move(dir) });
+      }
+
+      m_files.insert_or_assign(fname, stamp);
+    }
+    catch (std::bad_alloc&)
+    {
+      return false;
+    }
+
+    return true;
+  }
+
+  bool file_watch::wait(name_list& changed, time_type timeout) noexcept
+  {
+    std::array<HANDLE, MAXIMUM_WAIT_OBJECTS> handles{};
+    DWORD count{};
+    {
+      std::lock_guard lock{ m_lock };
+      for (auto&& dir : m_dirs)
+      {
+        handles[count++] = detail::to_handle(dir.handle);
+      }
+    }
+
+    if (!count)
+    {
+      std::this_thread::sleep_for(timeout);
+      return true;
+    }
+
+    const auto res = WaitForMultipleObjects(count, handles.data(), FALSE, static_cast<DWORD>(timeout.count()));
+    if (res == WAIT_TIMEOUT)
+      return true;
+
+    if (res < WAIT_OBJECT_0 || res >= WAIT_OBJECT_0 + count)
+      return false;
+
+    // Notifications only tell which directory to rescan
+    std::lock_guard lock{ m_lock };
+    auto&& dir = m_dirs[res - WAIT_OBJECT_0];
+    FindNextChangeNotification(detail::to_handle(dir.handle));
+    collect(dir.path, changed);
+    return true;
+  }
+}
+
+#endif
@@ -0,0 +1,77 @@
+#include "platform/raw_file.hpp"
+
+#if NEK_WINDOWS
+
+#include "platform/support/windows/win_includes.hpp"
+
+namespace neko::platform
+{
+  namespace detail
+  {
+    auto to_file(raw_file::handle_type h) noexcept
+    {
+      return reinterpret_cast<HANDLE>(h);
+    }
+  }
+
+  // Public members
+
+  bool raw_file::open(const name_type& fname) noexcept
+  {
+    close();
+    auto file = CreateFileW(fname.c_str(), GENERIC_WRITE, FILE_SHARE_READ,
+                            nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+      return false;
+
+    m_file = reinterpret_cast<handle_type>(file);
+    return true;
+  }
+
+  bool raw_file::rewind() noexcept
+  {
+    if (m_file == -1)
+      return false;
+
+    auto file = detail::to_file(m_file);
+    LARGE_INTEGER pos{};
+    return SetFilePointerEx(file, pos, nullptr, FILE_BEGIN) && SetEndOfFile(file);
+  }
+
+  bool raw_file::write(value_type str) noexcept
+  {
+    if (m_file == -1)
+      return false;
+
+    auto file = detail::to_file(m_file);
+    auto cur  = str.data();
+    auto left = str.size();
+    while (left)
+    {
+      constexpr auto chunkMax = std::size_t{ MAXDWORD };
+      const auto chunk = static_cast<DWORD>(std::min(left, chunkMax));
+      DWORD written{};
+      if (!WriteFile(file, cur, chunk, &written, nullptr) || !written)
+        return false;
+
+      cur  += written;
+      left -= written;
+    }
+
+    return true;
+  }
+
+  bool raw_file::sync() noexcept
+  {
+    return m_file != -1 && FlushFileBuffers(detail::to_file(m_file));
+  }
+
+  // Private members
+
+  void raw_file::release() noexcept
+  {
+    CloseHandle(detail::to_file(m_file));
+  }
+}
+
+#endif
@@ -174,7 +174,7 @@ namespace neko::platform
 
         if (!RegisterClassEx(&wc))
         {
-          NEK_TRACE("RegisterClassEx failed with code {}", GetLastError());
+          NEK_TRACE_IN(platform, "RegisterClassEx failed with code {}", GetLastError());
           return decltype(inst_handle){};
         }
 
@@ -269,7 +269,7 @@ namespace neko::platform
       return;
     }
 
-    NEK_TRACE("Closing window");
+    NEK_TRACE_IN(platform, "Closing window");
     using detail::wnd_helper;
 
     SetWindowLongPtr(m_info.handle, GWLP_USERDATA, 0);
@@ -285,7 +285,7 @@ namespace neko::platform
   {
     if (!*this)
     {
-      NEK_TRACE("Window is about to close");
+      NEK_TRACE_IN(platform, "Window is about to close");
       return false;
     }
 
@@ -309,7 +309,7 @@ namespace neko::platform
 
   void window::init() noexcept
   {
-    NEK_TRACE("Window init");
+    NEK_TRACE_IN(platform, "Window init");
 
   #ifdef NDEBUG
     ShowWindow(GetConsoleWindow(), SW_HIDE);
@@ -318,17 +318,17 @@ namespace neko::platform
     using detail::wnd_helper;
     auto className   = wnd_helper::windowClass.data();
     auto inst_handle = wnd_helper::make_wnd_class(className);
-    NEK_TRACE("Window class {}", wnd_helper::windowClass);
+    NEK_TRACE_IN(platform, "Window class {}", wnd_helper::windowClass);
     if (!inst_handle)
     {
       logger::error("Unable to register window class");
       return;
     }
 
-    NEK_TRACE("Window class registered");
+    NEK_TRACE_IN(platform, "Window class registered");
     auto [posX, posY, width, height] = wnd_helper::calc_size();
     m_info.size = { width, height };
-    NEK_TRACE("Window size: [{}, {}]", width, height);
+    NEK_TRACE_IN(platform, "Window size: [{}, {}]", width, height);
     auto handle = CreateWindow(
       className,
       nullptr,
@@ -345,7 +345,7 @@ namespace neko::platform
       return;
     }
 
-    NEK_TRACE("Window created");
+    NEK_TRACE_IN(platform, "Window created");
     SetWindowPos(handle, HWND_TOP, posX, posY, width, height,
                  SWP_NOOWNERZORDER | SWP_FRAMECHANGED);
 
@@ -355,7 +355,7 @@ namespace neko::platform
     using handle_type = host_info::handle_type;
     m_info.handle = reinterpret_cast<handle_type>(handle);
     
-    NEK_TRACE("Done init window");
+    NEK_TRACE_IN(platform, "Done init window");
   }
 
   void window::dispatch_events() noexcept
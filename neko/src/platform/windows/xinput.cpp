@@ -12,9 +12,9 @@ namespace neko::platform
 
   xinput::xinput() noexcept
   {
-    NEK_TRACE("Detecting connected XInput devices");
+    NEK_TRACE_IN(platform, "Detecting connected XInput devices");
     detect_devices();
-    NEK_TRACE("Number of connected controllers: {}", m_ports.count());
+    NEK_TRACE_IN(platform, "Number of connected controllers: {}", m_ports.count());
   }
 
   // Public members
@@ -53,7 +53,7 @@ namespace neko::platform
     #ifndef NDEBUG
       if (portState != m_ports[idx])
       {
-        NEK_TRACE("Controller {} was {}", idx, (portState ? "connected"sv : "disconnected"sv));
+        NEK_TRACE_IN(platform, "Controller {} was {}", idx, (portState ? "connected"sv : "disconnected"sv));
       }
     #endif
       m_ports[idx] = portState;
@@ -68,7 +68,7 @@ namespace neko::platform
     const auto portState = XInputGetState(idx, &devState);
     if (portState != ERROR_SUCCESS)
     {
-      NEK_TRACE("Controller {} was disconnected", idx);
+      NEK_TRACE_IN(platform, "Controller {} was disconnected", idx);
       m_ports[idx] = false;
       return;
     }
@@ -0,0 +1,98 @@
+//
+// Generated benchmark input
+//
+
+#pragma once
+
+namespace neko_bench::corpus
+{
+  using size_type = std::size_t;
+  using text_type = std::string;
+  using path_type = fsys::path;
+  using name_type = std::string_view;
+
+  //
+  // An inclusive range a random count is picked from
+  //
+  struct range
+  {
+    unsigned lo{};
+    unsigned hi{};
+  };
+
+  //
+  // Shape of generated config text
+  //
+  struct shape
+  {
+    //
+    // Name the shape is reported by
+    //
+    name_type name;
+
+    //
+    // Maximum nesting level of sections
+    //
+    unsigned depth{};
+
+    //
+    // Number of options in each section
+    //
+    range options;
+
+    //
+    // Number of subsections in each section above the maximum level
+    //
+    range sections;
+
+    //
+    // Number of values in each option
+    //
+    range values;
+
+    //
+    // Kinds of values, picked evenly from the range:
+    // 0 - integers, 1 - floats, 2 - bools, 3 - strings
+    //
+    range kinds;
+
+    //
+    // Minimum length of string values
+    // Shorter ones are padded with filler text
+    //
+    unsigned strLength{};
+  };
+
+  //
+  // Predefined shapes
+  // - mixed:   a bit of everything, a few levels deep
+  // - deep:    chains of single subsections nested far down
+  // - wide:    flat sections with hundreds of options each
+  // - lists:   options with long value lists
+  // - strings: long string values only
+  //
+  inline constexpr std::array shapes{
+    shape{ "mixed"sv,    3, {   2,  12 }, { 0, 3 }, {  1,   6 }, { 0, 3 },   0 },
+    shape{ "deep"sv,    32, {   1,   3 }, { 1, 1 }, {  1,   3 }, { 0, 3 },   0 },
+    shape{ "wide"sv,     0, { 200, 400 }, { 0, 0 }, {  1,   3 }, { 0, 3 },   0 },
+    shape{ "lists"sv,    1, {   1,   4 }, { 0, 2 }, { 64, 256 }, { 0, 3 },   0 },
+    shape{ "strings"sv,  2, {   2,   8 }, { 0, 2 }, {  1,   4 }, { 3, 3 }, 512 },
+  };
+
+  //
+  // Generates config text of roughly the specified size
+  // The same shape and seed always produce the same text
+  //
+  text_type make_config(size_type size, const shape& sh, std::uint32_t seed = 1);
+
+  //
+  // Generates config text of the mixed shape
+  //
+  text_type make_config(size_type size, std::uint32_t seed = 1);
+
+  //
+  // Writes text to a file
+  // Returns false on failure
+  //
+  bool write(const path_type& fname, std::string_view text) noexcept;
+}
@@ -0,0 +1,199 @@
+//
+// Benchmark harness
+//
+
+#pragma once
+
+namespace neko_bench
+{
+  using size_type  = std::size_t;
+  using clock_type = std::chrono::steady_clock;
+  using name_type  = std::string_view;
+  using case_fn    = void(*)();
+
+  //
+  // Results of a single measurement
+  //
+  struct stats
+  {
+    //
+    // Total number of operations
+    //
+    size_type ops{};
+
+    //
+    // Wall time of the whole run in seconds
+    //
+    double seconds{};
+
+    //
+    // Median and 99th percentile latency of one operation in nanoseconds
+    //
+    double p50{};
+    double p99{};
+
+    //
+    // Number of input bytes processed, zero if not applicable
+    //
+    size_type bytes{};
+
+    //
+    // Number of items processed, such as tokens or nodes,
+    // zero if not applicable
+    //
+    size_type items{};
+  };
+
+  //
+  // Command line options
+  //
+  struct options
+  {
+    //
+    // Only cases whose names contain this string are run
+    //
+    name_type filter;
+
+    //
+    // Size of generated corpus files in bytes
+    //
+    size_type corpusSize{ 4 * 1024 * 1024 };
+
+    //
+    // Results are printed as JSON lines rather than a table
+    //
+    bool json{};
+  };
+
+  //
+  // Parses the command line
+  // Returns an empty optional if it is malformed
+  //
+  std::optional<options> parse_options(int argc, char** argv) noexcept;
+
+  //
+  // Returns options of the current run
+  //
+  const options& settings() noexcept;
+
+  //
+  // Registers a benchmark case
+  // Used by the BENCH macro, the return value is only needed for static init
+  //
+  bool add_case(name_type name, case_fn fn) noexcept;
+
+  //
+  // Runs all registered cases matching the options
+  // Returns the number of cases run
+  //
+  size_type run_cases(const options& opts) noexcept;
+
+  //
+  // Prints a result line for the current case
+  //
+  void report(name_type name, const stats& res) noexcept;
+
+  namespace detail
+  {
+    //
+    // Latency is sampled over batches of operations,
+    // timing each one would mostly measure the clock
+    //
+    inline constexpr auto batchSize = size_type{ 16 };
+
+    using sample_vec = std::vector<double>;
+
+    //
+    // Runs ops operations, appending per-operation latency samples
+    //
+    template <typename Fn>
+    void sample(size_type ops, sample_vec& samples, Fn& fn)
+    {
+      samples.reserve(samples.size() + ops / batchSize + 1);
+      for (auto idx = size_type{}; idx < ops;)
+      {
+        const auto count = std::min(batchSize, ops - idx);
+        const auto start = clock_type::now();
+        for (const auto last = idx + count; idx < last; ++idx)
+        {
+          fn(idx);
+        }
+        const auto elapsed = std::chrono::duration<double, std::nano>(clock_type::now() - start);
+        samples.push_back(elapsed.count() / static_cast<double>(count));
+      }
+    }
+
+    //
+    // Fills percentiles from collected samples
+    //
+    void finish(stats& res, sample_vec& samples) noexcept;
+  }
+
+  //
+  // Calls fn(index) the specified number of times and measures it
+  //
+  template <typename Fn>
+  stats measure(size_type ops, Fn&& fn)
+  {
+    detail::sample_vec samples;
+    const auto start = clock_type::now();
+    detail::sample(ops, samples, fn);
+    const auto elapsed = std::chrono::duration<double>(clock_type::now() - start);
+
+    stats res;
+    res.ops = ops;
+    res.seconds = elapsed.count();
+    detail::finish(res, samples);
+    return res;
+  }
+
+  //
+  // Calls fn(index) from several threads at once, each thread
+  // doing the specified number of operations
+  // Latency percentiles are computed over samples from all threads
+  //
+  template <typename Fn>
+  stats measure_threads(size_type threads, size_type opsPerThread, Fn&& fn)
+  {
+    std::vector<detail::sample_vec> samples(threads);
+    std::vector<std::jthread> workers;
+    workers.reserve(threads);
+
+    std::latch ready{ static_cast<std::ptrdiff_t>(threads + 1) };
+    for (auto& s : samples)
+    {
+      workers.emplace_back([&ready, &s, &fn, opsPerThread]
+        {
+          ready.arrive_and_wait();
+          detail::sample(opsPerThread, s, fn);
+        });
+    }
+
+    const auto start = clock_type::now();
+    ready.arrive_and_wait();
+    workers.clear();
+    const auto elapsed = std::chrono::duration<double>(clock_type::now() - start);
+
+    detail::sample_vec all;
+    for (auto& s : samples)
+    {
+      all.insert(all.end(), s.begin(), s.end());
+    }
+
+    stats res;
+    res.ops = threads * opsPerThread;
+    res.seconds = elapsed.count();
+    detail::finish(res, all);
+    return res;
+  }
+}
+
+//
+// Defines a benchmark case
+// The name is reported as 'group.name'
+//
+#define BENCH(group, name)\
+  static void bench_##group##_##name();\
+  [[maybe_unused]] static const bool bench_##group##_##name##_reg =\
+    neko_bench::add_case(#group "." #name, bench_##group##_##name);\
+  static void bench_##group##_##name()
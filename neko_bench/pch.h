@@ -0,0 +1,8 @@
+#pragma once
+
+#include "../neko/pch.h"
+#include "utils/utils.hpp"
+
+#include <latch>
+#include <cstdio>
+#include <random>
@@ -0,0 +1,420 @@
+#include "bench/harness.hpp"
+#include "bench/corpus.hpp"
+#include "config/conf.hpp"
+#include "config/parser/lex.hpp"
+using namespace neko::config;
+
+namespace neko_bench
+{
+  namespace detail
+  {
+    constexpr auto corpusName = "bench_corpus.cfg"sv;
+    constexpr auto corpusSize = size_type{ 16 * 1024 * 1024 };
+    constexpr auto cfgOps     = size_type{ 16 };
+    constexpr auto lookupOps  = size_type{ 1'000'000 };
+
+    //
+    // Generates the corpus file once and returns its size
+    //
+    size_type corpus_file() noexcept
+    {
+      static const auto size = []() noexcept -> size_type
+        {
+          try
+          {
+            const auto text = corpus::make_config(corpusSize);
+            return corpus::write(corpusName, text) ? text.size() : 0;
+          }
+          catch (std::exception&)
+          {
+            return 0;
+          }
+        }();
+
+      return size;
+    }
+
+    //
+    // Keeps results alive so that the work isn't optimised out
+    //
+    volatile size_type sink{};
+  }
+
+  BENCH(config, lex)
+  {
+    const auto size = detail::corpus_file();
+    if (!size)
+      return;
+
+    cfg_file file{ detail::corpusName };
+    auto res = measure(detail::cfgOps, [&file](size_type)
+      {
+        file.rewind();
+        lex l{ file };
+        auto tokens = size_type{};
+        while (l)
+        {
+          if (!l.next())
+            break;
+
+          ++tokens;
+        }
+        detail::sink = tokens;
+      });
+
+    res.bytes = size * res.ops;
+    report("", res);
+  }
+
+  BENCH(config, parse)
+  {
+    const auto size = detail::corpus_file();
+    if (!size)
+      return;
+
+    auto res = measure(detail::cfgOps, [](size_type)
+      {
+        cfg c{ detail::corpusName };
+        detail::sink = static_cast<bool>(c);
+      });
+
+    res.bytes = size * res.ops;
+    report("", res);
+  }
+
+  BENCH(config, cached)
+  {
+    const auto size = detail::corpus_file();
+    if (!size)
+      return;
+
+    // The first load compiles the image, the rest only hash the source
+    // and rebuild the tree from the image
+    {
+      cfg c{ detail::corpusName, cfg::cache_policy::cached };
+      if (!c)
+        return;
+    }
+
+    auto res = measure(detail::cfgOps, [](size_type)
+      {
+        cfg c{ detail::corpusName, cfg::cache_policy::cached };
+        detail::sink = c.from_image();
+      });
+
+    res.bytes = size * res.ops;
+    report("", res);
+  }
+
+  namespace detail
+  {
+    //
+    // A small frozen tree three levels deep
+    //
+    const section& query_tree() noexcept
+    {
+      static const auto& root = []() -> const section&
+        {
+          static section res{ "root"sv };
+          auto&& sec = res.add_section("render"sv).add_section("shadows"sv);
+          sec.add_option("resolution"sv).add_value(2048ll);
+          res.freeze();
+          return res;
+        }();
+
+      return root;
+    }
+  }
+
+  BENCH(config, lookup_chain)
+  {
+    const auto& root = detail::query_tree();
+    report("", measure(detail::lookupOps, [&root](size_type)
+      {
+        auto sec = root.get_section("render"sv);
+        sec = sec ? sec->get_section("shadows"sv) : nullptr;
+        detail::sink = sec && sec->get_option("resolution"sv);
+      }));
+  }
+
+  BENCH(config, lookup_query)
+  {
+    using neko::operator""_ncq;
+    constexpr auto path = "render.shadows.resolution"_ncq;
+
+    const auto& root = detail::query_tree();
+    report("", measure(detail::lookupOps, [&root, &path](size_type)
+      {
+        detail::sink = static_cast<bool>(root.get_option(path));
+      }));
+  }
+
+  BENCH(config, lookup_interned)
+  {
+    const auto render  = name_pool::intern("render"sv);
+    const auto shadows = name_pool::intern("shadows"sv);
+    const auto resolution = name_pool::intern("resolution"sv);
+
+    const auto& root = detail::query_tree();
+    report("", measure(detail::lookupOps, [&](size_type)
+      {
+        auto sec = root.get_section(render);
+        sec = sec ? sec->get_section(shadows) : nullptr;
+        detail::sink = sec && sec->get_option(resolution);
+      }));
+  }
+
+  namespace detail
+  {
+    constexpr auto tableSize = size_type{ 64 * 1024 };
+    constexpr auto tableOps  = size_type{ 256 };
+
+    //
+    // A table of floats stored both packed and as values
+    // The unpacked copy is built one value at a time, which never packs
+    //
+    const section& float_table() noexcept
+    {
+      static const auto& root = []() -> const section&
+        {
+          static section res{ "root"sv };
+          std::vector<value> vals;
+          vals.reserve(tableSize);
+          auto&& plain = res.add_option("plain"sv);
+          for (auto idx = size_type{}; idx < tableSize; ++idx)
+          {
+            const auto val = static_cast<value::float_val>(idx % 100) * 0.01f;
+            vals.emplace_back(val);
+            plain.add_value(val);
+          }
+
+          res.add_option("packed"sv).add_values(vals);
+          res.freeze();
+          return res;
+        }();
+
+      return root;
+    }
+  }
+
+  BENCH(config, table_values)
+  {
+    const auto& opt = *detail::float_table().get_option("plain"sv);
+    auto res = measure(detail::tableOps, [&opt](size_type)
+      {
+        auto sum = value::float_val{};
+        for (auto&& val : opt)
+        {
+          if (auto f = val.try_get<value::float_val>())
+            sum += *f;
+        }
+        detail::sink = static_cast<size_type>(sum);
+      });
+
+    res.items = detail::tableSize * res.ops;
+    report("", res);
+  }
+
+  BENCH(config, table_span)
+  {
+    const auto& opt = *detail::float_table().get_option("packed"sv);
+    auto res = measure(detail::tableOps, [&opt](size_type)
+      {
+        auto sum = value::float_val{};
+        for (auto f : opt.as_span<value::float_val>())
+          sum += f;
+
+        detail::sink = static_cast<size_type>(sum);
+      });
+
+    res.items = detail::tableSize * res.ops;
+    report("", res);
+  }
+
+  namespace detail
+  {
+    constexpr auto lookupStride = size_type{ 7919 };
+
+    //
+    // A generated corpus file of a particular shape
+    //
+    struct shaped_corpus
+    {
+      const corpus::shape* shape{};
+      corpus::path_type    path;
+      size_type            size{};
+    };
+
+    //
+    // Generates corpus files of all shapes once
+    // The size is taken from the command line
+    // Files which couldn't be generated have zero size
+    //
+    const auto& shaped_corpora() noexcept
+    {
+      static const auto files = []() noexcept
+        {
+          std::array<shaped_corpus, corpus::shapes.size()> res{};
+          const auto size = settings().corpusSize;
+          for (auto idx = 0ull; idx < res.size(); ++idx)
+          {
+            auto&& sh = corpus::shapes[idx];
+            auto&& item = res[idx];
+            item.shape = &sh;
+            try
+            {
+              item.path = std::format("bench_corpus_{}.cfg", sh.name);
+              const auto text = corpus::make_config(size, sh);
+              item.size = corpus::write(item.path, text) ? text.size() : 0;
+            }
+            catch (std::exception&)
+            {
+              item.size = 0;
+            }
+          }
+          return res;
+        }();
+
+      return files;
+    }
+
+    //
+    // Runs a measurement for each corpus shape
+    // Results are reported as 'case/shape'
+    //
+    template <typename Fn>
+    void for_each_shape(Fn&& fn)
+    {
+      for (auto&& item : shaped_corpora())
+      {
+        if (item.size)
+          fn(item);
+      }
+    }
+
+    size_type count_nodes(const section& sec) noexcept
+    {
+      auto res = size_type{ 1 } + sec.options().size();
+      for (auto sub : sec.sections())
+      {
+        res += count_nodes(*sub);
+      }
+      return res;
+    }
+
+    //
+    // Names of sections leading to an option, followed by its own name
+    //
+    using name_path = std::vector<std::string_view>;
+    using path_list = std::vector<name_path>;
+
+    void collect_paths(const section& sec, name_path& prefix, path_list& out)
+    {
+      for (auto opt : sec.options())
+      {
+        out.push_back(prefix);
+        out.back().push_back(opt->name());
+      }
+      for (auto sub : sec.sections())
+      {
+        prefix.push_back(sub->name());
+        collect_paths(*sub, prefix, out);
+        prefix.pop_back();
+      }
+    }
+  }
+
+  BENCH(corpus, read)
+  {
+    detail::for_each_shape([](const detail::shaped_corpus& item)
+      {
+        auto lines = size_type{};
+        auto res = measure(detail::cfgOps, [&item, &lines](size_type)
+          {
+            cfg_file file{ item.path };
+            lines = 0;
+            while (file)
+            {
+              file.line();
+              ++lines;
+            }
+            detail::sink = lines;
+          });
+
+        res.bytes = item.size * res.ops;
+        res.items = lines * res.ops;
+        report(item.shape->name, res);
+      });
+  }
+
+  BENCH(corpus, lex)
+  {
+    detail::for_each_shape([](const detail::shaped_corpus& item)
+      {
+        cfg_file file{ item.path };
+        auto tokens = size_type{};
+        auto res = measure(detail::cfgOps, [&file, &tokens](size_type)
+          {
+            file.rewind();
+            lex l{ file };
+            tokens = 0;
+            while (l && l.next())
+            {
+              ++tokens;
+            }
+            detail::sink = tokens;
+          });
+
+        res.bytes = item.size * res.ops;
+        res.items = tokens * res.ops;
+        report(item.shape->name, res);
+      });
+  }
+
+  BENCH(corpus, parse)
+  {
+    detail::for_each_shape([](const detail::shaped_corpus& item)
+      {
+        auto nodes = size_type{};
+        auto res = measure(detail::cfgOps, [&item, &nodes](size_type)
+          {
+            cfg c{ item.path };
+            nodes = c ? detail::count_nodes(*c) : 0;
+            detail::sink = nodes;
+          });
+
+        res.bytes = item.size * res.ops;
+        res.items = nodes * res.ops;
+        report(item.shape->name, res);
+      });
+  }
+
+  BENCH(corpus, lookup)
+  {
+    detail::for_each_shape([](const detail::shaped_corpus& item)
+      {
+        cfg c{ item.path };
+        if (!c)
+          return;
+
+        detail::path_list paths;
+        detail::name_path prefix;
+        detail::collect_paths(*c, prefix, paths);
+        if (paths.empty())
+          return;
+
+        // Options are visited in a scattered order, so that neighbouring
+        // lookups don't share cache lines
+        report(item.shape->name, measure(detail::lookupOps, [&c, &paths](size_type idx)
+          {
+            auto&& path = paths[idx * detail::lookupStride % paths.size()];
+            auto sec = &*c;
+            for (auto name = path.begin(); sec && name != path.end() - 1; ++name)
+            {
+              sec = sec->get_section(*name);
+            }
+            detail::sink = sec && sec->get_option(path.back());
+          }));
+      });
+  }
+}
@@ -0,0 +1,132 @@
+#include "bench/harness.hpp"
+using neko::logger;
+using neko::logging::kv;
+
+namespace neko_bench
+{
+  namespace detail
+  {
+    constexpr auto logOps     = size_type{ 200'000 };
+    constexpr auto logThreads = size_type{ 4 };
+
+    //
+    // Sets the logger up for a measurement and shuts it down afterwards
+    // Console output is disabled, messages only go to the file sink
+    // Rate limiting and repeat collapsing are off, so that every
+    // message reaches the formatter
+    //
+    class log_setup
+    {
+    public:
+      CLASS_SPECIALS_NONE(log_setup);
+
+      explicit log_setup(logger::level lvl) noexcept
+      {
+        logger::assign_file("bench.log"sv);
+        logger::init();
+        logger::echo(false);
+        logger::set_severity_level(lvl);
+        logger::set_rate_limit(0, {});
+        logger::collapse_repeats(false);
+        logger::set_rotation(file_type::defaultMaxSize, file_type::defaultMaxFiles);
+      }
+
+      ~log_setup() noexcept
+      {
+        logger::shutdown();
+      }
+
+    private:
+      using file_type = neko::logging::log_file;
+    };
+  }
+
+  BENCH(logger, note_no_args)
+  {
+    detail::log_setup _{ logger::dbg };
+    report("", measure(detail::logOps, [](size_type)
+      {
+        logger::note("A message without arguments");
+      }));
+  }
+
+  BENCH(logger, note_int)
+  {
+    detail::log_setup _{ logger::dbg };
+    report("", measure(detail::logOps, [](size_type idx)
+      {
+        logger::note("Message number {}", idx);
+      }));
+  }
+
+  BENCH(logger, note_mixed)
+  {
+    detail::log_setup _{ logger::dbg };
+    report("", measure(detail::logOps, [](size_type idx)
+      {
+        logger::note("Message {} at {:.3f}: '{}' is {}", idx, idx * 0.25, "some text"sv, idx % 2 == 0);
+      }));
+  }
+
+  BENCH(logger, note_fields)
+  {
+    detail::log_setup _{ logger::dbg };
+    report("text", measure(detail::logOps, [](size_type idx)
+      {
+        logger::note("Message with fields", kv("index", idx), kv("name", "value"sv));
+      }));
+
+    const auto prev = logger::set_output(logger::output::json);
+    report("json", measure(detail::logOps, [](size_type idx)
+      {
+        logger::note("Message with fields", kv("index", idx), kv("name", "value"sv));
+      }));
+    logger::set_output(prev);
+  }
+
+  BENCH(logger, trace)
+  {
+    detail::log_setup _{ logger::dbg };
+    report("", measure(detail::logOps, [](size_type idx)
+      {
+        NEK_TRACE_IN(core, "Trace message {}", idx);
+      }));
+  }
+
+  BENCH(logger, filtered)
+  {
+    detail::log_setup _{ logger::err };
+    report("runtime", measure(detail::logOps, [](size_type idx)
+      {
+        logger::note("Filtered message {}", idx);
+      }));
+
+    logger::set_category_level(logger::category::game, logger::off);
+    report("category", measure(detail::logOps, [](size_type idx)
+      {
+        NEK_LOG(game, err, "Filtered message {}", idx);
+      }));
+    logger::reset_category_level(logger::category::game);
+  }
+
+  BENCH(logger, rotation)
+  {
+    detail::log_setup _{ logger::dbg };
+    constexpr auto maxSize  = size_type{ 1024 * 1024 };
+    constexpr auto maxFiles = size_type{ 2 };
+    logger::set_rotation(maxSize, maxFiles);
+    report("", measure(detail::logOps, [](size_type idx)
+      {
+        logger::note("Message {} at {:.3f}: '{}' is {}", idx, idx * 0.25, "some text"sv, idx % 2 == 0);
+      }));
+  }
+
+  BENCH(logger, threads)
+  {
+    detail::log_setup _{ logger::dbg };
+    report("", measure_threads(detail::logThreads, detail::logOps / detail::logThreads, [](size_type idx)
+      {
+        logger::note("Message {} at {:.3f}: '{}' is {}", idx, idx * 0.25, "some text"sv, idx % 2 == 0);
+      }));
+  }
+}
@@ -0,0 +1,26 @@
+#include "bench/harness.hpp"
+
+//
+// Usage: neko_bench [--json] [--size=<bytes>] [filter]
+// Runs cases whose names contain the filter, or all of them
+// --json prints results as JSON lines
+// --size sets the size of generated corpus files
+//
+int main(int argc, char** argv)
+{
+  const auto opts = neko_bench::parse_options(argc, argv);
+  if (!opts)
+  {
+    std::printf("Usage: neko_bench [--json] [--size=<bytes>] [filter]\n");
+    return 1;
+  }
+
+  if (!neko_bench::run_cases(*opts))
+  {
+    const auto filter = opts->filter;
+    std::printf("No benchmarks matching '%.*s'\n", static_cast<int>(filter.size()), filter.data());
+    return 1;
+  }
+
+  return 0;
+}
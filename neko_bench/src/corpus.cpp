@@ -0,0 +1,142 @@
+#include "bench/corpus.hpp"
+
+namespace neko_bench::corpus
+{
+  namespace detail
+  {
+    constexpr auto indentSize = 2u;
+    constexpr auto strFiller  = " with some text"sv;
+
+    class generator
+    {
+    public:
+      generator(text_type& out, const shape& sh, std::uint32_t seed) noexcept :
+        m_out{ out },
+        m_shape{ sh },
+        m_rng{ seed }
+      { }
+
+      void section(unsigned depth)
+      {
+        indent(depth);
+        std::format_to(std::back_inserter(m_out), ".section_{}\n", m_id++);
+        indent(depth);
+        m_out += "{\n";
+
+        const auto options = pick(m_shape.options);
+        for (auto idx = 0u; idx < options; ++idx)
+        {
+          option(depth + 1);
+        }
+
+        if (depth < m_shape.depth)
+        {
+          const auto subsections = pick(m_shape.sections);
+          for (auto idx = 0u; idx < subsections; ++idx)
+          {
+            section(depth + 1);
+          }
+        }
+
+        indent(depth);
+        m_out += "}\n\n";
+      }
+
+    private:
+      unsigned pick(unsigned lo, unsigned hi) noexcept
+      {
+        return std::uniform_int_distribution<unsigned>{ lo, hi }(m_rng);
+      }
+      unsigned pick(range r) noexcept
+      {
+        return pick(r.lo, r.hi);
+      }
+
+      void indent(unsigned depth)
+      {
+        m_out.append(depth * indentSize, ' ');
+      }
+
+      void option(unsigned depth)
+      {
+        indent(depth);
+        auto out = std::format_to(std::back_inserter(m_out), "option_{}{{ ", m_id++);
+
+        const auto values = pick(m_shape.values);
+        for (auto idx = 0u; idx < values; ++idx)
+        {
+          if (idx)
+            out = std::format_to(out, ", ");
+
+          switch (pick(m_shape.kinds))
+          {
+          case 0:
+            out = std::format_to(out, "{}", static_cast<int>(m_rng() % 200001) - 100000);
+            break;
+          case 1:
+            out = std::format_to(out, "{:.3f}", static_cast<float>(m_rng() % 100000) / 16.0f);
+            break;
+          case 2:
+            out = std::format_to(out, "{}", m_rng() % 2 == 0);
+            break;
+          default:
+            string_value(m_rng() % 1000);
+            break;
+          }
+        }
+
+        m_out += " }\n";
+      }
+
+      //
+      // Writes a numbered string padded with filler text to the shape's length
+      //
+      void string_value(unsigned num)
+      {
+        const auto start = m_out.size();
+        std::format_to(std::back_inserter(m_out), "'string value {}{}", num, strFiller);
+        const auto length = start + m_shape.strLength + 1;
+        while (m_out.size() < length)
+        {
+          m_out += strFiller.substr(0, length - m_out.size());
+        }
+        m_out += '\'';
+      }
+
+    private:
+      text_type& m_out;
+      const shape& m_shape;
+      std::minstd_rand m_rng;
+      unsigned m_id{};
+    };
+  }
+
+  text_type make_config(size_type size, const shape& sh, std::uint32_t seed)
+  {
+    text_type res;
+    res.reserve(size + size / 8);
+
+    detail::generator gen{ res, sh, seed };
+    while (res.size() < size)
+    {
+      gen.section(0);
+    }
+
+    return res;
+  }
+
+  text_type make_config(size_type size, std::uint32_t seed)
+  {
+    return make_config(size, shapes.front(), seed);
+  }
+
+  bool write(const path_type& fname, std::string_view text) noexcept
+  {
+    std::ofstream out{ fname, std::ios::binary | std::ios::trunc };
+    if (!out)
+      return false;
+
+    out.write(text.data(), static_cast<std::streamsize>(text.size()));
+    return static_cast<bool>(out);
+  }
+}
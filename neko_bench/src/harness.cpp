@@ -0,0 +1,150 @@
+#include "bench/harness.hpp"
+
+namespace neko_bench
+{
+  namespace detail
+  {
+    struct bench_case
+    {
+      name_type name;
+      case_fn   fn{};
+    };
+
+    auto& cases() noexcept
+    {
+      static std::vector<bench_case> registered;
+      return registered;
+    }
+
+    name_type currentCase{};
+
+    options currentOptions{};
+
+    double percentile(sample_vec& samples, double pct) noexcept
+    {
+      if (samples.empty())
+        return {};
+
+      const auto pos = static_cast<size_type>(pct * static_cast<double>(samples.size() - 1));
+      auto nth = samples.begin() + static_cast<std::ptrdiff_t>(pos);
+      std::nth_element(samples.begin(), nth, samples.end());
+      return *nth;
+    }
+
+    void finish(stats& res, sample_vec& samples) noexcept
+    {
+      res.p50 = percentile(samples, 0.5);
+      res.p99 = percentile(samples, 0.99);
+    }
+  }
+
+  bool add_case(name_type name, case_fn fn) noexcept
+  {
+    try
+    {
+      detail::cases().push_back({ name, fn });
+      return true;
+    }
+    catch (std::bad_alloc&)
+    {
+      return false;
+    }
+  }
+
+  std::optional<options> parse_options(int argc, char** argv) noexcept
+  {
+    constexpr auto jsonOpt = "--json"sv;
+    constexpr auto sizeOpt = "--size="sv;
+
+    options res;
+    for (auto idx = 1; idx < argc; ++idx)
+    {
+      const name_type arg{ argv[idx] };
+      if (arg == jsonOpt)
+      {
+        res.json = true;
+        continue;
+      }
+
+      if (arg.starts_with(sizeOpt))
+      {
+        const auto val = arg.substr(sizeOpt.size());
+        const auto last = val.data() + val.size();
+        const auto conv = std::from_chars(val.data(), last, res.corpusSize);
+        if (conv.ec != std::errc{} || conv.ptr != last || !res.corpusSize)
+          return {};
+
+        continue;
+      }
+
+      if (arg.starts_with("--"sv) || !res.filter.empty())
+        return {};
+
+      res.filter = arg;
+    }
+
+    return res;
+  }
+
+  const options& settings() noexcept
+  {
+    return detail::currentOptions;
+  }
+
+  size_type run_cases(const options& opts) noexcept
+  {
+    detail::currentOptions = opts;
+    if (!opts.json)
+    {
+      std::printf("%-32s %14s %10s %10s %10s %10s %14s\n",
+                  "case", "ops/s", "ns/op", "p50 ns", "p99 ns", "MB/s", "items/s");
+    }
+
+    auto count = size_type{};
+    for (auto&& bc : detail::cases())
+    {
+      if (!opts.filter.empty() && bc.name.find(opts.filter) == name_type::npos)
+        continue;
+
+      detail::currentCase = bc.name;
+      bc.fn();
+      ++count;
+    }
+
+    detail::currentCase = {};
+    return count;
+  }
+
+  void report(name_type name, const stats& res) noexcept
+  {
+    const auto opsPerSec = res.seconds > 0.0 ? static_cast<double>(res.ops) / res.seconds : 0.0;
+    const auto nsPerOp   = res.ops ? res.seconds * 1e9 / static_cast<double>(res.ops) : 0.0;
+
+    // Cases with several measurements report them as 'case/name'
+    std::array<char, 64> fullName{};
+    std::snprintf(fullName.data(), fullName.size(), "%.*s%s%.*s",
+                  static_cast<int>(detail::currentCase.size()), detail::currentCase.data(),
+                  name.empty() ? "" : "/",
+                  static_cast<int>(name.size()), name.data());
+
+    const auto mbPerSec    = res.seconds > 0.0 ? static_cast<double>(res.bytes) / res.seconds / 1e6 : 0.0;
+    const auto itemsPerSec = res.seconds > 0.0 ? static_cast<double>(res.items) / res.seconds : 0.0;
+
+    // Case names consist of identifiers, dots and slashes,
+    // nothing needs escaping
+    if (detail::currentOptions.json)
+    {
+      std::printf("{\"case\":\"%s\",\"ops\":%zu,\"seconds\":%.6f,\"ops_per_sec\":%.1f,\"ns_per_op\":%.1f,"
+                  "\"p50_ns\":%.1f,\"p99_ns\":%.1f,\"bytes\":%zu,\"mb_per_sec\":%.2f,"
+                  "\"items\":%zu,\"items_per_sec\":%.1f}\n",
+                  fullName.data(), res.ops, res.seconds, opsPerSec, nsPerOp,
+                  res.p50, res.p99, res.bytes, mbPerSec, res.items, itemsPerSec);
+    }
+    else
+    {
+      std::printf("%-32s %14.0f %10.1f %10.1f %10.1f %10.1f %14.0f\n",
+                  fullName.data(), opsPerSec, nsPerOp, res.p50, res.p99, mbPerSec, itemsPerSec);
+    }
+    std::fflush(stdout);
+  }
+}
@@ -0,0 +1,39 @@
+//
+// Allocation counting
+//
+
+#pragma once
+
+namespace neko_tests
+{
+  namespace detail
+  {
+    void start_probe() noexcept;
+    std::size_t stop_probe() noexcept;
+  }
+
+  //
+  // Returns the number of allocations made so far through the global
+  // operator new, which the test executable replaces
+  //
+  std::size_t alloc_count() noexcept;
+
+  //
+  // Makes the n-th allocation of the given size, counting from this call,
+  // throw std::bad_alloc. Only allocations made by the calling thread count
+  // Zero n cancels the failure
+  //
+  void fail_alloc(std::size_t size, std::size_t n) noexcept;
+
+  //
+  // Calls a function and returns the size of the first allocation
+  // it made on the calling thread, zero if there were none
+  //
+  template <typename Fn>
+  std::size_t first_alloc_size(Fn&& fn)
+  {
+    detail::start_probe();
+    fn();
+    return detail::stop_probe();
+  }
+}
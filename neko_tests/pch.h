@@ -3,6 +3,9 @@
 #include "../neko/pch.h"
 #include "utils/utils.hpp"
 
+#include <atomic>
+#include <cstdlib>
+
 // third-party headers
 #ifdef GTEST_BUILT
   #include "gtest/gtest.h"
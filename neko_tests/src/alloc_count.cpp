@@ -0,0 +1,70 @@
+#include "alloc_count.hpp"
+
+namespace neko_tests
+{
+  namespace detail
+  {
+    std::atomic_size_t allocCount{};
+
+    //
+    // Injected failure and probing, per thread
+    //
+    thread_local std::size_t failSize{};
+    thread_local std::size_t failLeft{};
+    thread_local bool probing{};
+    thread_local std::size_t probeSize{};
+
+    void start_probe() noexcept
+    {
+      probeSize = {};
+      probing = true;
+    }
+
+    std::size_t stop_probe() noexcept
+    {
+      probing = false;
+      return probeSize;
+    }
+
+    void on_alloc(std::size_t size)
+    {
+      ++allocCount;
+      if (probing && !probeSize)
+        probeSize = size;
+
+      if (failLeft && size == failSize && !--failLeft)
+        throw std::bad_alloc{};
+    }
+  }
+
+  std::size_t alloc_count() noexcept
+  {
+    return detail::allocCount.load();
+  }
+
+  void fail_alloc(std::size_t size, std::size_t n) noexcept
+  {
+    detail::failSize = size;
+    detail::failLeft = n;
+  }
+}
+
+//
+// Counts every allocation made by the test executable
+//
+void* operator new(std::size_t size)
+{
+  neko_tests::detail::on_alloc(size);
+  if (auto ptr = std::malloc(size ? size : 1))
+    return ptr;
+
+  throw std::bad_alloc{};
+}
+void operator delete(void* ptr) noexcept
+{
+  std::free(ptr);
+}
+void operator delete(void* ptr, std::size_t) noexcept
+{
+  std::free(ptr);
+}
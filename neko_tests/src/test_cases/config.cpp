@@ -1,5 +1,10 @@
 #include "config/conf.hpp"
+#include "config/binding.hpp"
+#include "config/writer.hpp"
+#include "platform/file_watch.hpp"
+#include "managers/config.hpp"
 #include "config/parser/lex.hpp"
+#include "alloc_count.hpp"
 
 using namespace neko::config;
 using token = lex::token;
@@ -34,7 +39,8 @@ namespace neko_tests
       ASSERT_EQ(size, opt.size());
       ASSERT_LT(idx, size);
 
-      auto v = opt[idx].try_get<T>();
+      const auto val = opt[idx];
+      auto v = val.try_get<T>();
       ASSERT_TRUE(v);
 
       if constexpr (std::is_floating_point_v<T>)
@@ -46,6 +52,75 @@ namespace neko_tests
         ASSERT_EQ(*v, expected);
       }
     }
+
+    void write_file(const fsys::path& path, std::string_view text)
+    {
+      std::ofstream out{ path };
+      out << text;
+    }
+
+    //
+    // Creates the config manager for a directory
+    // and shuts it down at the end of the scope
+    //
+    struct manager_scope
+    {
+      using mgr_type = neko::singleton<neko::conf_manager>;
+
+      explicit manager_scope(const fsys::path& root) noexcept
+      {
+        created = mgr_type::create<neko::conf_manager>(root);
+      }
+      ~manager_scope() noexcept
+      {
+        mgr_type::shutdown();
+      }
+
+      neko::conf_manager& get() noexcept
+      {
+        return mgr_type::get();
+      }
+
+      bool created{};
+    };
+
+    //
+    // Calls update on the manager until the predicate holds or time runs out
+    //
+    template <typename Pred>
+    bool update_until(neko::conf_manager& mgr, Pred&& pred)
+    {
+      for (auto attempt = 0; attempt < 40; ++attempt)
+      {
+        std::this_thread::sleep_for(std::chrono::milliseconds{ 50 });
+        mgr.update();
+        if (pred())
+          return true;
+      }
+      return false;
+    }
+
+    bool same_tree(const section& l, const section& r)
+    {
+      auto&& lo = l.options();
+      auto&& ro = r.options();
+      auto&& ls = l.sections();
+      auto&& rs = r.sections();
+      if (l.name() != r.name() || lo.size() != ro.size() || ls.size() != rs.size())
+        return false;
+
+      for (auto idx = 0ull; idx < lo.size(); ++idx)
+      {
+        if (lo[idx]->name() != ro[idx]->name() || !std::ranges::equal(*lo[idx], *ro[idx]))
+          return false;
+      }
+      for (auto idx = 0ull; idx < ls.size(); ++idx)
+      {
+        if (!same_tree(*ls[idx], *rs[idx]))
+          return false;
+      }
+      return true;
+    }
   }
 
   TEST(conf, t_option)
@@ -68,6 +143,41 @@ namespace neko_tests
     EXPECT_EQ(10, (val.get<value::int_val>()));
   }
 
+  TEST(conf, t_value)
+  {
+    constexpr auto text = "some text"sv;
+    value val{ text.substr(0, 4) };
+    EXPECT_EQ(val.type(), value::kind::string);
+    ASSERT_TRUE((val.try_get<value::str_val>()));
+    EXPECT_EQ(*val.try_get<value::str_val>(), "some"sv);
+    EXPECT_EQ((val.get<value::str_val>().data()), text.data());
+    EXPECT_FALSE((val.try_get<value::int_val>()));
+
+    // Strings are compared by contents
+    const std::string copy{ "some" };
+    EXPECT_EQ(val, value{ std::string_view{ copy } });
+    EXPECT_NE(val, value{ text });
+
+    // Reassignment changes the type
+    val = 5;
+    EXPECT_TRUE(val.is<value::int_val>());
+    EXPECT_FALSE(val.is<value::str_val>());
+    EXPECT_EQ(val, value{ 5ll });
+    EXPECT_NE(val, value{ 5.0f });
+
+    val.get<value::int_val>() = 7;
+    EXPECT_EQ((val.get<value::int_val>()), 7);
+
+    val = 0.5;
+    ASSERT_TRUE((val.try_get<value::float_val>()));
+    *val.try_get<value::float_val>() = 1.5f;
+    EXPECT_DOUBLE_EQ((val.get<value::float_val>()), 1.5f);
+
+    val = true;
+    EXPECT_EQ(val.type(), value::kind::boolean);
+    EXPECT_NE(val, value{ 1ll });
+  }
+
   TEST(conf, t_section_add_get)
   {
     section s{ "glob"sv };
@@ -113,19 +223,23 @@ namespace neko_tests
     const auto& optAdd = s.add_option(optName);
     ASSERT_EQ(optAdd.size(), 4);
 
-    auto ip = optAdd[0].try_get<value::int_val>();
+    const auto intv = optAdd[0];
+    auto ip = intv.try_get<value::int_val>();
     ASSERT_TRUE(ip);
     EXPECT_EQ(*ip, intVal);
 
-    auto bp = optAdd[1].try_get<value::bool_val>();
+    const auto boolv = optAdd[1];
+    auto bp = boolv.try_get<value::bool_val>();
     ASSERT_TRUE(bp);
     EXPECT_EQ(*bp, boolVal);
 
-    auto fp = optAdd[2].try_get<value::float_val>();
+    const auto floatv = optAdd[2];
+    auto fp = floatv.try_get<value::float_val>();
     ASSERT_TRUE(fp);
     EXPECT_DOUBLE_EQ(*fp, floatVal);
 
-    auto sp = optAdd[3].try_get<value::str_val>();
+    const auto strv = optAdd[3];
+    auto sp = strv.try_get<value::str_val>();
     ASSERT_TRUE(sp);
     EXPECT_EQ(*sp, strVal);
 
@@ -135,6 +249,103 @@ namespace neko_tests
     EXPECT_EQ((opt[3].get<value::str_val>()), strVal);
   }
 
+  TEST(conf, t_packed)
+  {
+    section s{ "packed"sv };
+    const auto count = option::packMin;
+
+    // Integers
+    std::vector<value> vals;
+    for (auto idx = 0ll; idx < static_cast<value::int_val>(count); ++idx)
+      vals.emplace_back(idx * 3);
+
+    auto&& ints = s.add_option("ints"sv);
+    ints.add_values(vals);
+    ASSERT_TRUE(ints.packed());
+    auto intSpan = ints.as_span<value::int_val>();
+    ASSERT_EQ(intSpan.size(), count);
+    EXPECT_EQ(intSpan[5], 15);
+    EXPECT_TRUE(ints.as_span<value::float_val>().empty());
+    EXPECT_FALSE(ints.bits());
+    EXPECT_EQ(ints.value_at(7), value{ 21ll });
+    EXPECT_EQ(ints[7], value{ 21ll });
+    EXPECT_TRUE(std::ranges::equal(ints, vals));
+
+    // Too short or of mixed types
+    auto&& shortList = s.add_option("short"sv);
+    shortList.add_values(std::span{ vals }.first(count - 1));
+    EXPECT_FALSE(shortList.packed());
+    EXPECT_EQ(shortList.size(), count - 1);
+
+    vals.emplace_back(1.0f);
+    auto&& mixed = s.add_option("mixed"sv);
+    mixed.add_values(vals);
+    EXPECT_FALSE(mixed.packed());
+    detail::check_opt_value(mixed, count + 1, count, 1.0f);
+
+    // Floats and bools
+    vals.clear();
+    for (auto idx = 0u; idx < count; ++idx)
+      vals.emplace_back(idx * 0.5f);
+
+    auto&& floats = s.add_option("floats"sv);
+    floats.add_values(vals);
+    ASSERT_EQ(floats.as_span<value::float_val>().size(), count);
+    EXPECT_DOUBLE_EQ(floats.as_span<value::float_val>()[3], 1.5f);
+
+    vals.clear();
+    for (auto idx = 0u; idx < count * 3; ++idx)
+      vals.emplace_back(idx % 3 == 0);
+
+    auto&& bools = s.add_option("bools"sv);
+    bools.add_values(vals);
+    auto bits = bools.bits();
+    ASSERT_TRUE(bits);
+    ASSERT_EQ(bits->size(), count * 3);
+    EXPECT_TRUE((*bits)[3]);
+    EXPECT_FALSE((*bits)[4]);
+    EXPECT_TRUE(std::ranges::equal(bools, vals));
+
+    // Changing a value unpacks
+    floats.set_value(3, 2.5f);
+    EXPECT_FALSE(floats.packed());
+    detail::check_opt_value(floats, count, 3, 2.5f);
+    detail::check_opt_value(floats, count, 4, 2.0f);
+
+    // Adding a value of another type unpacks
+    bools.add_value(7ll);
+    EXPECT_FALSE(bools.packed());
+    detail::check_opt_value(bools, count * 3 + 1, 3, true);
+    detail::check_opt_value(bools, count * 3 + 1, count * 3, 7ll);
+
+    // Parsed and cached lists are packed the same way
+    constexpr auto fname = "tests/cfg/gen_packed.txt"sv;
+    {
+      std::ofstream out{ fsys::path{ fname } };
+      out << "list{ ";
+      for (auto idx = 0u; idx < count * 2; ++idx)
+        out << idx << ", ";
+      out << "}\nfew{ 1, 2, 3 }\n";
+    }
+
+    std::error_code err;
+    fsys::remove(cfg_image::name_for(fname), err);
+    for (auto fromImage : { false, true })
+    {
+      cfg c{ fname, cfg::cache_policy::cached };
+      ASSERT_TRUE(c);
+      EXPECT_EQ(c.from_image(), fromImage);
+      auto list = detail::get_option(*c, "list"sv);
+      ASSERT_TRUE(list->packed());
+      auto listSpan = list->as_span<value::int_val>();
+      ASSERT_EQ(listSpan.size(), count * 2);
+      EXPECT_EQ(listSpan.back(), static_cast<value::int_val>(count * 2 - 1));
+      auto few = detail::get_option(*c, "few"sv);
+      EXPECT_FALSE(few->packed());
+      detail::check_opt_value(*few, 3, 2, 3ll);
+    }
+  }
+
   TEST(conf, t_opt_base)
   {
     section s{ "empty"sv };
@@ -260,6 +471,7 @@ namespace neko_tests
 
     cfg_file f{ fname };
     EXPECT_FALSE(f);
+    EXPECT_FALSE(f.mapped());
     EXPECT_TRUE(f.line().empty());
   }
 
@@ -279,6 +491,7 @@ namespace neko_tests
 
     cfg_file f{ fname };
     ASSERT_TRUE(f);
+    EXPECT_TRUE(f.mapped());
 
     auto line = f.line();
     EXPECT_EQ(line, ".section");
@@ -292,6 +505,22 @@ namespace neko_tests
     EXPECT_FALSE(f);
   }
 
+  TEST(conf_file, t_blank_end)
+  {
+    // Blank lines at the end are skipped without reading past the data
+    constexpr auto fname = "tests/cfg/gen_blank_end.txt"sv;
+    detail::write_file(fname, "first\n\n  \n"sv);
+
+    for (auto store : { cfg_file::storage::mapped, cfg_file::storage::owned })
+    {
+      cfg_file f{ fname, store };
+      ASSERT_TRUE(f);
+      EXPECT_EQ(f.line(), "first"sv);
+      EXPECT_TRUE(f.line().empty());
+      EXPECT_FALSE(f);
+    }
+  }
+
   TEST(conf_lex, t_good)
   {
     constexpr auto fname = "tests/cfg/lex_good.txt"sv;
@@ -378,6 +607,809 @@ namespace neko_tests
     EXPECT_TRUE(!l);
   }
 
+  TEST(conf_lex, t_int_limits)
+  {
+    constexpr auto fname = "tests/cfg/lex_int.txt"sv;
+
+    // -9223372036854775808, 9223372036854775807, 9223372036854775808
+
+    cfg_file f{ fname };
+    ASSERT_TRUE(f);
+
+    lex l{ f };
+
+    auto tok = l.next();
+    ASSERT_TRUE(tok.is(token::intNum));
+    EXPECT_EQ(tok.intVal, std::numeric_limits<std::int64_t>::min());
+    ASSERT_TRUE(l.next().is(token::comma));
+
+    tok = l.next();
+    ASSERT_TRUE(tok.is(token::intNum));
+    EXPECT_EQ(tok.intVal, std::numeric_limits<std::int64_t>::max());
+    ASSERT_TRUE(l.next().is(token::comma));
+
+    EXPECT_TRUE(l.next().is(token::unknown));
+    EXPECT_TRUE(!l);
+  }
+
+  TEST(conf_parser, t_arena)
+  {
+    constexpr auto fname = "tests/cfg/gen_arena.txt"sv;
+    constexpr auto sectionCount = 100;
+    constexpr auto optionCount  = 10;
+
+    {
+      std::ofstream out{ fsys::path{ fname } };
+      ASSERT_TRUE(out);
+      for (auto s = 0; s < sectionCount; ++s)
+      {
+        out << ".section" << s << "\n{\n";
+        for (auto o = 0; o < optionCount; ++o)
+        {
+          out << "  option" << o << "{ " << o << ", 'value', true }\n";
+        }
+        out << "}\n";
+      }
+    }
+
+    const auto before = alloc_count();
+    cfg c{ fname };
+    const auto allocs = alloc_count() - before;
+    ASSERT_TRUE(c);
+
+    auto sec = c->get_section("section42"sv);
+    ASSERT_TRUE(sec);
+
+    auto opt = detail::get_option(*sec, "option7"sv);
+    detail::check_opt_value(*opt, 3, 0, 7ll);
+
+    // Over a thousand nodes, but memory comes from a handful of arena blocks
+    EXPECT_LE(allocs, 8u);
+  }
+
+  TEST(conf_parser, t_cache)
+  {
+    constexpr auto fname = "tests/cfg/gen_cache.txt"sv;
+    const auto imageName = cfg_image::name_for(fname);
+
+    auto generate = [fname](std::string_view value)
+    {
+      std::ofstream out{ fsys::path{ fname } };
+      out << ".outer\n{\n  .inner\n  {\n    opt{ 42, -1.5, false, '" << value << "' }\n  }\n}\n";
+    };
+
+    std::error_code err;
+    fsys::remove(imageName, err);
+    generate("first"sv);
+
+    auto check = [](const cfg& c, std::string_view value)
+    {
+      ASSERT_TRUE(c);
+      auto outer = c->get_section("outer"sv);
+      ASSERT_TRUE(outer);
+      auto inner = outer->get_section("inner"sv);
+      ASSERT_TRUE(inner);
+      EXPECT_EQ(inner->parent(), outer);
+
+      auto opt = detail::get_option(*inner, "opt"sv);
+      detail::check_opt_value(*opt, 4, 0, 42ll);
+      detail::check_opt_value(*opt, 4, 1, -1.5f);
+      detail::check_opt_value(*opt, 4, 2, false);
+      detail::check_opt_value(*opt, 4, 3, value);
+    };
+
+    // No image yet, the file is parsed and the image is written
+    {
+      cfg c{ fname, cfg::cache_policy::cached };
+      EXPECT_FALSE(c.from_image());
+      check(c, "first"sv);
+      ASSERT_TRUE(fsys::exists(imageName));
+    }
+
+    // The image is up to date
+    {
+      cfg c{ fname, cfg::cache_policy::cached };
+      EXPECT_TRUE(c.from_image());
+      check(c, "first"sv);
+    }
+
+    // The source has changed, the image is stale
+    generate("second"sv);
+    {
+      cfg c{ fname, cfg::cache_policy::cached };
+      EXPECT_FALSE(c.from_image());
+      check(c, "second"sv);
+    }
+
+    {
+      cfg c{ fname, cfg::cache_policy::cached };
+      EXPECT_TRUE(c.from_image());
+      check(c, "second"sv);
+    }
+
+    // With owned storage, the tree doesn't refer to the files on disk
+    {
+      cfg c{ fname, cfg::cache_policy::cached, cfg::storage::owned };
+      EXPECT_TRUE(c.from_image());
+      generate("third"sv);
+      fsys::remove(imageName, err);
+      check(c, "second"sv);
+    }
+  }
+
+  TEST(conf_parser, t_stream)
+  {
+    constexpr auto fname = "tests/cfg/gen_stream.txt"sv;
+    {
+      std::ofstream out{ fsys::path{ fname } };
+      out << "top{ 1, 'a string longer than a chunk', 2.5 }\n\n   \n";
+      for (auto idx = 0; idx < 50; ++idx)
+      {
+        out << ".sec" << idx << "\n{\n  name{ 'value " << idx << "' }\n"
+            << "  vals{ " << idx << ", -" << idx << ".25, true }\n"
+            << "  .inner { str{ 'deep' } }\n}\n";
+      }
+      out << "last{ 'no line break' }";
+    }
+
+    cfg mapped{ fname };
+    ASSERT_TRUE(mapped);
+    for (auto chunkSize : { 1ull, 7ull, 64ull, 4096ull })
+    {
+      cfg streamed{ fname, chunkSize };
+      ASSERT_TRUE(streamed);
+      EXPECT_TRUE(detail::same_tree(*mapped, *streamed));
+    }
+  }
+
+  TEST(conf, t_watch)
+  {
+    using neko::platform::file_watch;
+    const auto fname = fsys::absolute("tests/cfg/gen_watch.txt");
+    const auto other = fsys::absolute("tests/cfg/gen_watch_other.txt");
+    auto write = [](const fsys::path& path, std::string_view text)
+    {
+      std::ofstream out{ path };
+      out << text;
+    };
+
+    write(fname, "opt{ 1 }"sv);
+    write(other, "opt{ 1 }"sv);
+
+    file_watch watch;
+    ASSERT_TRUE(watch);
+    ASSERT_TRUE(watch.add(fname));
+
+    // Make sure the write time is different
+    std::this_thread::sleep_for(std::chrono::milliseconds{ 50 });
+    write(other, "opt{ 2 }"sv);
+    write(fname, "opt{ 2 }"sv);
+
+    file_watch::name_list changed;
+    for (auto attempt = 0; attempt < 20 && changed.empty(); ++attempt)
+    {
+      ASSERT_TRUE(watch.wait(changed, std::chrono::milliseconds{ 100 }));
+    }
+
+    ASSERT_EQ(changed.size(), 1u);
+    EXPECT_EQ(changed.front(), fname);
+
+    // Nothing has changed since
+    changed.clear();
+    ASSERT_TRUE(watch.wait(changed, std::chrono::milliseconds{ 100 }));
+    EXPECT_TRUE(changed.empty());
+  }
+
+  TEST(conf_manager, t_reload)
+  {
+    using change_evt = neko::evt::config_changed;
+    const auto root = fsys::absolute("tests/cfg");
+    const auto fname = root / "gen_reload.txt";
+    detail::write_file(fname, ".video { width{ 800 } }\n.audio { volume{ 0.5 } }\nname{ 'game' }\n"sv);
+
+    detail::manager_scope scope{ root };
+    ASSERT_TRUE(scope.created);
+    auto&& mgr = scope.get();
+    ASSERT_TRUE(mgr.load_file("reload", "gen_reload.txt"));
+
+    std::vector<change_evt> events;
+    neko::event_subscriber<change_evt> sub{ &events, [&events](const change_evt& e)
+      {
+        events.push_back(e);
+      }
+    };
+
+    // Make sure the write time is different
+    std::this_thread::sleep_for(std::chrono::milliseconds{ 50 });
+    detail::write_file(fname, ".video { width{ 1024 } }\n.audio { volume{ 0.5 } }\n.input { }\nname{ 'game' }\n"sv);
+    ASSERT_TRUE(detail::update_until(mgr, [&events] { return !events.empty(); }));
+
+    ASSERT_EQ(events.size(), 1u);
+    auto&& e = events.front();
+    EXPECT_TRUE(e.key == change_evt::key_type{ "reload" });
+    EXPECT_EQ(e.file, fsys::canonical(fname));
+    EXPECT_EQ(e.version, 2u);
+    EXPECT_TRUE(e.changed("video"sv));
+    EXPECT_TRUE(e.changed("input"sv));
+    EXPECT_FALSE(e.changed("audio"sv));
+    EXPECT_EQ(e.sections.size(), 2u);
+
+    auto conf = mgr.lookup("reload");
+    ASSERT_TRUE(conf);
+    auto video = (*conf)->get_section("video"sv);
+    ASSERT_TRUE(video);
+    auto width = detail::get_option(*video, "width"sv);
+    EXPECT_EQ((width->value_at(0).get<value::int_val>()), 1024);
+  }
+
+  TEST(conf_manager, t_snapshots)
+  {
+    using change_evt = neko::evt::config_changed;
+    const auto root = fsys::absolute("tests/cfg");
+    const auto fname = root / "gen_snapshot.txt";
+    detail::write_file(fname, ".video { width{ 800 } }\nname{ 'first version' }\n"sv);
+
+    detail::manager_scope scope{ root };
+    ASSERT_TRUE(scope.created);
+    auto&& mgr = scope.get();
+
+    auto missing = mgr.acquire("snapshot");
+    EXPECT_FALSE(missing);
+    EXPECT_EQ(missing.version(), 0u);
+
+    ASSERT_TRUE(mgr.load_file("snapshot", "gen_snapshot.txt"));
+    const auto first = mgr.acquire("snapshot");
+    ASSERT_TRUE(first);
+    EXPECT_EQ(first.version(), 1u);
+    EXPECT_EQ(first.get(), mgr.lookup("snapshot"));
+
+    // Snapshots can be taken and read on other threads
+    std::thread{ [&mgr]
+      {
+        auto conf = mgr.acquire("snapshot");
+        ASSERT_TRUE(conf);
+        EXPECT_EQ(conf.version(), 1u);
+        EXPECT_TRUE((*conf)->get_section("video"sv));
+      } }.join();
+
+    std::vector<change_evt> events;
+    neko::event_subscriber<change_evt> sub{ &events, [&events](const change_evt& e)
+      {
+        events.push_back(e);
+      }
+    };
+
+    // The file is rewritten in place, old snapshots don't refer to it
+    std::this_thread::sleep_for(std::chrono::milliseconds{ 50 });
+    detail::write_file(fname, "name{ 'v2' }\n"sv);
+    ASSERT_TRUE(detail::update_until(mgr, [&events] { return !events.empty(); }));
+
+    const auto second = mgr.acquire("snapshot");
+    ASSERT_TRUE(second);
+    EXPECT_EQ(second.version(), 2u);
+    ASSERT_EQ(events.size(), 1u);
+    EXPECT_EQ(events.front().version, second.version());
+    EXPECT_NE(second.get(), first.get());
+    EXPECT_FALSE((*second)->get_section("video"sv));
+
+    EXPECT_EQ(first.version(), 1u);
+    auto video = (*first)->get_section("video"sv);
+    ASSERT_TRUE(video);
+    detail::check_opt_value(*detail::get_option(*video, "width"sv), 1, 0, 800ll);
+    detail::check_opt_value(*detail::get_option(**first, "name"sv), 1, 0, "first version"sv);
+  }
+
+  TEST(conf_manager, t_load_results)
+  {
+    using load_item = neko::conf_manager::load_item;
+    using load_result = neko::conf_manager::load_result;
+    const auto root = fsys::absolute("tests/cfg");
+    detail::write_file(root / "gen_results1.txt", "one{ 1 }\n"sv);
+    detail::write_file(root / "gen_results2.txt", "two{ 2 }\n"sv);
+
+    detail::manager_scope scope{ root };
+    ASSERT_TRUE(scope.created);
+    auto&& mgr = scope.get();
+
+    const std::array batch{
+      load_item{ "one", "gen_results1.txt" },
+      load_item{ "one", "gen_results1.txt" },
+      load_item{ "two", "./gen_results1.txt" },
+      load_item{ "one", "gen_results2.txt" },
+      load_item{ "three", "gen_missing.txt" },
+      load_item{ "four", "parse_bad1.txt" },
+    };
+
+    const std::array first{
+      load_result::loaded,
+      load_result::present,
+      load_result::path_taken,
+      load_result::key_taken,
+      load_result::bad_path,
+      load_result::failed
+    };
+
+    auto report = mgr.load_files(batch);
+    ASSERT_EQ(report.size(), batch.size());
+    for (auto idx = 0ull; idx < batch.size(); ++idx)
+    {
+      EXPECT_EQ(report[idx], first[idx]) << "at " << idx;
+    }
+
+    EXPECT_TRUE(mgr.exists("one"));
+    EXPECT_FALSE(mgr.exists("two"));
+    EXPECT_FALSE(mgr.exists("three"));
+    EXPECT_FALSE(mgr.exists("four"));
+
+    auto conf = mgr.acquire("one");
+    ASSERT_TRUE(conf);
+    EXPECT_EQ(conf.version(), 1u);
+    EXPECT_TRUE((*conf)->get_option("one"sv));
+
+    // Loading the same batch again changes nothing
+    report = mgr.load_files(batch);
+    ASSERT_EQ(report.size(), batch.size());
+    EXPECT_EQ(report[0], load_result::present);
+    for (auto idx = 1ull; idx < batch.size(); ++idx)
+    {
+      EXPECT_EQ(report[idx], first[idx]) << "at " << idx;
+    }
+    EXPECT_EQ(mgr.acquire("one").get(), conf.get());
+  }
+
+  TEST(conf_manager, t_load_rollback)
+  {
+    using load_item = neko::conf_manager::load_item;
+    using load_result = neko::conf_manager::load_result;
+    const auto root = fsys::absolute("tests/cfg");
+    detail::write_file(root / "gen_batch1.txt", "one{ 1 }\n"sv);
+    detail::write_file(root / "gen_batch2.txt", "two{ 2 }\n"sv);
+    detail::write_file(root / "gen_batch3.txt", "three{ 3 }\n"sv);
+
+    // Parsed files are moved into shared blocks of this size as they
+    // are registered, so failing one fails the batch midway
+    const auto blockSize = first_alloc_size([]
+      {
+        auto probe = std::make_shared<const cfg>(fsys::path{});
+      });
+    ASSERT_NE(blockSize, 0u);
+
+    detail::manager_scope scope{ root };
+    ASSERT_TRUE(scope.created);
+    auto&& mgr = scope.get();
+
+    const std::array batch{
+      load_item{ "one", "gen_batch1.txt" },
+      load_item{ "two", "gen_batch2.txt" },
+      load_item{ "three", "gen_batch3.txt" },
+    };
+
+    for (auto failAt = 1ull; failAt <= batch.size(); ++failAt)
+    {
+      fail_alloc(blockSize, failAt);
+      const auto report = mgr.load_files(batch);
+      fail_alloc(blockSize, 0);
+
+      ASSERT_EQ(report.size(), batch.size());
+      for (auto idx = 0ull; idx < batch.size(); ++idx)
+      {
+        EXPECT_EQ(report[idx], load_result::failed) << "at " << idx << ", failed " << failAt;
+        EXPECT_FALSE(mgr.exists(batch[idx].first));
+        EXPECT_FALSE(mgr.acquire(batch[idx].first));
+      }
+    }
+
+    // Nothing is left of rolled back files
+    const auto report = mgr.load_files(batch);
+    ASSERT_EQ(report.size(), batch.size());
+    for (auto idx = 0ull; idx < batch.size(); ++idx)
+    {
+      EXPECT_EQ(report[idx], load_result::loaded);
+      EXPECT_TRUE(mgr.acquire(batch[idx].first));
+    }
+  }
+
+  TEST(conf_manager, t_includes)
+  {
+    using change_evt = neko::evt::config_changed;
+    const auto root = fsys::absolute("tests/cfg");
+    detail::write_file(root / "gen_inc_main.txt",
+      "include{ 'gen_inc_part.txt', './gen_inc_part.txt', 'gen_inc_shared.txt', 'gen_inc_missing.txt', 'parse_bad1.txt', 42 }\n"
+      ".loop { include{ 'gen_inc_loop.txt' } }\n"sv);
+    detail::write_file(root / "gen_inc_part.txt", "part{ 1 }\n"sv);
+    detail::write_file(root / "gen_inc_shared.txt", "shared{ 1 }\n"sv);
+    detail::write_file(root / "gen_inc_loop.txt", "include{ 'gen_inc_main.txt' }\n"sv);
+
+    detail::manager_scope scope{ root };
+    ASSERT_TRUE(scope.created);
+    auto&& mgr = scope.get();
+    ASSERT_TRUE(mgr.load_file("main", "gen_inc_main.txt"));
+    ASSERT_TRUE(mgr.load_file("shared", "gen_inc_shared.txt"));
+    auto main = mgr.lookup("main");
+    ASSERT_TRUE(main);
+
+    // Files written twice are included once, loaded files are shared,
+    // files which can't be loaded are skipped
+    auto incs = mgr.includes(**main);
+    ASSERT_EQ(incs.size(), 2u);
+    auto part = mgr.lookup("gen_inc_part.txt");
+    ASSERT_TRUE(part);
+    EXPECT_EQ(incs[0], part);
+    EXPECT_EQ(incs[1], mgr.lookup("shared"));
+    EXPECT_FALSE(mgr.exists("gen_inc_shared.txt"));
+    EXPECT_FALSE(mgr.exists("parse_bad1.txt"));
+
+    // Results are cached
+    EXPECT_EQ(mgr.includes(**main).data(), incs.data());
+
+    // Cycles end at files which are loaded already
+    auto loopSec = (*main)->get_section("loop"sv);
+    ASSERT_TRUE(loopSec);
+    auto loopIncs = mgr.includes(*loopSec);
+    ASSERT_EQ(loopIncs.size(), 1u);
+    auto loop = loopIncs[0];
+    auto backIncs = mgr.includes(**loop);
+    ASSERT_EQ(backIncs.size(), 1u);
+    EXPECT_EQ(backIncs[0], main);
+
+    // Reloads drop resolved includes
+    std::vector<change_evt> events;
+    neko::event_subscriber<change_evt> sub{ &events, [&events](const change_evt& e)
+      {
+        events.push_back(e);
+      }
+    };
+
+    auto oldPart = mgr.acquire("gen_inc_part.txt");
+    std::this_thread::sleep_for(std::chrono::milliseconds{ 50 });
+    detail::write_file(root / "gen_inc_part.txt", "part{ 2 }\n"sv);
+    ASSERT_TRUE(detail::update_until(mgr, [&events] { return !events.empty(); }));
+
+    part = mgr.lookup("gen_inc_part.txt");
+    ASSERT_TRUE(part);
+    EXPECT_NE(part, oldPart.get());
+    incs = mgr.includes(**main);
+    ASSERT_EQ(incs.size(), 2u);
+    EXPECT_EQ(incs[0], part);
+    auto opt = detail::get_option(**part, "part"sv);
+    detail::check_opt_value(*opt, 1, 0, 2ll);
+  }
+
+  TEST(conf, t_freeze)
+  {
+    section s{ "glob"sv };
+    constexpr std::array names{ "one"sv, "two"sv, "three"sv, "four"sv, "five"sv };
+    for (auto name : names)
+    {
+      s.add_section(name).add_option(name).add_value(true);
+      s.add_option(name).add_value(false);
+    }
+
+    ASSERT_TRUE(s.freeze());
+    ASSERT_TRUE(s.frozen());
+
+    // File order is kept
+    auto secs = s.sections();
+    auto opts = s.options();
+    ASSERT_EQ(secs.size(), names.size());
+    ASSERT_EQ(opts.size(), names.size());
+    for (auto idx = 0ull; idx < names.size(); ++idx)
+    {
+      EXPECT_EQ(secs[idx]->name(), names[idx]);
+      EXPECT_EQ(opts[idx]->name(), names[idx]);
+      EXPECT_TRUE(secs[idx]->frozen());
+    }
+
+    for (auto name : names)
+    {
+      auto sec = s.get_section(name);
+      ASSERT_TRUE(sec);
+      EXPECT_EQ(sec->name(), name);
+      EXPECT_EQ(sec->parent(), &s);
+      EXPECT_TRUE(sec->get_option(name));
+
+      auto opt = s.get_option(name);
+      ASSERT_TRUE(opt);
+      EXPECT_EQ(opt->name(), name);
+    }
+
+    EXPECT_FALSE(s.get_section("six"sv));
+    EXPECT_FALSE(s.get_option("six"sv));
+    EXPECT_FALSE(s.get_section("one"sv)->get_option("two"sv));
+  }
+
+  TEST(conf, t_names)
+  {
+    constexpr auto optName = "t_names_option"sv;
+    const auto id = name_pool::intern(optName);
+    ASSERT_TRUE(id);
+    EXPECT_EQ(id.str(), optName);
+    EXPECT_EQ(id.hash(), keys::hash(optName));
+
+    const std::string copy{ optName };
+    EXPECT_EQ(name_pool::intern(copy), id);
+    EXPECT_EQ(name_pool::find(copy), id);
+    EXPECT_FALSE(name_pool::find("t_names_never_interned"sv));
+
+    // Names are shared between sections and trees
+    section first{ "first"sv };
+    section second{ "second"sv };
+    auto&& nested = first.add_section("t_names_section"sv).add_option(copy);
+    auto&& flat = second.add_option(optName);
+    EXPECT_EQ(nested.name().data(), id.str().data());
+    EXPECT_EQ(flat.name().data(), id.str().data());
+
+    // Lookups by id work the same before and after freezing
+    auto check = [&]()
+    {
+      auto sec = first.get_section(name_pool::find("t_names_section"sv));
+      ASSERT_TRUE(sec);
+      EXPECT_EQ(sec->get_option(id), &nested);
+      EXPECT_EQ(second.get_option(id), &flat);
+      EXPECT_EQ(second.get_option(optName), &flat);
+      EXPECT_FALSE(second.get_section(id));
+      EXPECT_FALSE(second.get_option(name_id{}));
+    };
+
+    check();
+    ASSERT_TRUE(first.freeze());
+    ASSERT_TRUE(second.freeze());
+    check();
+  }
+
+  TEST(conf, t_names_threads)
+  {
+    // Enough names to make the table grow a few times
+    constexpr auto nameCount = 5000u;
+    constexpr auto threadCount = 4u;
+    std::vector<std::string> names;
+    for (auto idx = 0u; idx < nameCount; ++idx)
+      names.emplace_back("t_names_threads_" + std::to_string(idx));
+
+    // Every thread interns all names, starting at different points
+    std::array<std::vector<name_id>, threadCount> ids;
+    {
+      std::vector<std::jthread> threads;
+      for (auto th = 0u; th < threadCount; ++th)
+      {
+        threads.emplace_back([&names, &res = ids[th], th]
+          {
+            res.resize(nameCount);
+            for (auto step = 0u; step < nameCount; ++step)
+            {
+              const auto idx = (step + th * nameCount / threadCount) % nameCount;
+              res[idx] = name_pool::intern(names[idx]);
+            }
+          });
+      }
+    }
+
+    for (auto idx = 0u; idx < nameCount; ++idx)
+    {
+      const auto id = name_pool::find(names[idx]);
+      ASSERT_TRUE(id);
+      EXPECT_EQ(id.str(), names[idx]);
+      for (auto&& res : ids)
+      {
+        EXPECT_EQ(res[idx], id);
+      }
+    }
+  }
+
+  TEST(conf, t_query)
+  {
+    using neko::operator""_ncq;
+
+    constexpr auto q = "render.shadows.size"_ncq;
+    static_assert(q.segments().size() == 3);
+    static_assert(q.leaf().hash == keys::hash("size"sv));
+
+    EXPECT_FALSE(query{ ""sv });
+    EXPECT_FALSE(query{ "a..b"sv });
+    EXPECT_FALSE(query{ "a."sv });
+    EXPECT_FALSE(query{ "a.b.c.d.e.f.g.h.i"sv });
+    EXPECT_TRUE(query{ "a.b.c.d.e.f.g.h"sv });
+
+    section root{ "root"sv };
+    auto&& shadows = root.add_section("render"sv).add_section("shadows"sv);
+    shadows.add_option("size"sv).add_value(2048ll);
+    root.add_option("size"sv).add_value(1ll);
+
+    for (auto frozen : { false, true })
+    {
+      if (frozen)
+        ASSERT_TRUE(root.freeze());
+
+      EXPECT_EQ(root.get_section("render.shadows"_ncq), &shadows);
+      EXPECT_EQ(root.get_option(q), shadows.get_option("size"sv));
+      EXPECT_EQ(root.get_option("size"_ncq), root.get_option("size"sv));
+      EXPECT_FALSE(root.get_option("render.size"_ncq));
+      EXPECT_FALSE(root.get_option("render.lights.size"_ncq));
+      EXPECT_FALSE(root.get_section("render.shadows.size"_ncq));
+    }
+  }
+
+  TEST(conf, t_binding)
+  {
+    using neko::operator""_ncq;
+
+    struct unit
+    {
+      std::int64_t     hp;
+      int              armor;
+      float            speed;
+      bool             flying;
+      std::string_view name;
+    };
+
+    binding bind{
+      field{ "stats.hp"_ncq,    &unit::hp, 100 },
+      field{ "stats.armor"_ncq, &unit::armor },
+      field{ "speed"_ncq,       &unit::speed, 1.0f },
+      field{ "flying"_ncq,      &unit::flying },
+      field{ "names"_ncq,       &unit::name, "none"sv, 1 }
+    };
+
+    section root{ "root"sv };
+    constexpr std::array names{ "one"sv, "two"sv, "three"sv };
+    for (auto idx = 0ll; idx < 3; ++idx)
+    {
+      auto&& sec = root.add_section(names[idx]);
+
+      // The last one has a different layout and a wrong type for speed
+      if (idx == 2)
+        sec.add_option("speed"sv).add_value(true);
+
+      sec.add_option("flying"sv).add_value(idx == 1);
+      auto&& stats = sec.add_section("stats"sv);
+      stats.add_option("hp"sv).add_value(10 + idx);
+      stats.add_option("armor"sv).add_value(5ll);
+      if (idx != 2)
+        sec.add_option("speed"sv).add_value(2.5f);
+
+      auto&& nameOpt = sec.add_option("names"sv);
+      nameOpt.add_value("short"sv);
+      nameOpt.add_value(names[idx]);
+    }
+    ASSERT_TRUE(root.freeze());
+
+    const auto before = alloc_count();
+    for (auto idx = 0ll; auto sec : root.sections())
+    {
+      unit u{};
+      const auto bound = bind.bind(*sec, u);
+      EXPECT_EQ(u.hp, 10 + idx);
+      EXPECT_EQ(u.armor, 5);
+      EXPECT_EQ(u.flying, idx == 1);
+      EXPECT_EQ(u.name, names[idx]);
+      if (idx == 2)
+      {
+        EXPECT_EQ(bound, 4u);
+        EXPECT_FLOAT_EQ(u.speed, 1.0f);
+      }
+      else
+      {
+        EXPECT_EQ(bound, 5u);
+        EXPECT_FLOAT_EQ(u.speed, 2.5f);
+      }
+      ++idx;
+    }
+    EXPECT_EQ(alloc_count(), before);
+
+    // Nothing is there, defaults all the way
+    section empty{ "empty"sv };
+    unit u{};
+    EXPECT_EQ(bind.bind(empty, u), 0u);
+    EXPECT_EQ(u.hp, 100);
+    EXPECT_EQ(u.name, "none"sv);
+  }
+
+  TEST(conf, t_writer)
+  {
+    const fsys::path fname{ "tests/cfg/gen_writer.txt"sv };
+    auto read = [&fname]()
+    {
+      std::ifstream in{ fname, std::ios::binary };
+      return std::string{ std::istreambuf_iterator<char>{ in }, {} };
+    };
+    auto write = [&fname](std::string_view text)
+    {
+      std::ofstream out{ fname, std::ios::binary };
+      out << text;
+    };
+
+    section root{ "root"sv };
+    root.add_option("ver"sv).add_value(3ll);
+    auto&& game = root.add_section("game"sv);
+    game.add_option("name"sv).add_value("Neko sandbox"sv);
+    auto&& mult = game.add_option("mult"sv);
+    mult.add_value(-1ll);
+    mult.add_value(2.0f);
+    mult.add_value(true);
+    game.add_section("inner"sv).add_option("size"sv).add_value(0.1f);
+
+    // Full text
+    std::string text;
+    ASSERT_TRUE(cfg_writer::to_text(root, text));
+    EXPECT_EQ(text, "ver{ 3 }\n"
+                    ".game\n{\n"
+                    "  name{ 'Neko sandbox' }\n"
+                    "  mult{ -1, 2.0, true }\n"
+                    "  .inner\n  {\n    size{ 0.1 }\n  }\n"
+                    "}\n"sv);
+
+    // Reads back the same
+    ASSERT_TRUE(cfg_writer::save(root, fname));
+    {
+      cfg c{ fname };
+      ASSERT_TRUE(c);
+      auto opt = c->get_section("game"sv)->get_option("mult"sv);
+      ASSERT_TRUE(opt);
+      EXPECT_TRUE(std::ranges::equal(*opt, mult));
+      auto size = c->get_section("game"sv)->get_section("inner"sv)->get_option("size"sv);
+      ASSERT_TRUE(size);
+      detail::check_opt_value(*size, 1, 0, 0.1f);
+    }
+
+    // Equal values written differently are left alone,
+    // items missing from the tree are removed
+    write("ver{3}\n"
+          ".game\n{\n"
+          "    name{   'Neko sandbox'   }\n"
+          "  old{ 1 }\n"
+          "  mult{ -1, 2.00, true, }\n"
+          "  .inner { size{ 0.10 } }\n"
+          "}\n"
+          ".extra\n{\n}\n"sv);
+    ASSERT_TRUE(cfg_writer::update(root, fname));
+    const auto formatted = "ver{3}\n"
+                           ".game\n{\n"
+                           "    name{   'Neko sandbox'   }\n"
+                           "  mult{ -1, 2.00, true, }\n"
+                           "  .inner { size{ 0.10 } }\n"
+                           "}\n"sv;
+    EXPECT_EQ(read(), formatted);
+
+    // Nothing to change
+    ASSERT_TRUE(cfg_writer::update(root, fname));
+    EXPECT_EQ(read(), formatted);
+
+    // Changed values are rewritten, new items are added
+    root.get_option("ver"sv)->set_value(0, 4ll);
+    game.add_option("added"sv).add_value(false);
+    ASSERT_TRUE(cfg_writer::update(root, fname));
+    EXPECT_EQ(read(), "ver{ 4 }\n"
+                      ".game\n{\n"
+                      "    name{   'Neko sandbox'   }\n"
+                      "  mult{ -1, 2.00, true, }\n"
+                      "  .inner { size{ 0.10 } }\n"
+                      "  added{ false }\n"
+                      "}\n"sv);
+
+    // Mapped files can be saved over, trees built from them stay intact
+    {
+      cfg mapped{ fname };
+      ASSERT_TRUE(mapped);
+
+      section other{ "root"sv };
+      other.add_option("ver"sv).add_value(5ll);
+      ASSERT_TRUE(cfg_writer::save(other, fname));
+      EXPECT_EQ(read(), "ver{ 5 }\n"sv);
+      EXPECT_FALSE(fsys::exists(fsys::path{ fname } += ".tmp"));
+
+      auto ver = detail::get_option(*mapped, "ver"sv);
+      detail::check_opt_value(*ver, 1, 0, 4ll);
+      auto name = detail::get_option(*mapped->get_section("game"sv), "name"sv);
+      detail::check_opt_value(*name, 1, 0, "Neko sandbox"sv);
+    }
+
+    // Strings can't have quotes
+    section bad{ "bad"sv };
+    bad.add_option("str"sv).add_value("it's"sv);
+    text.clear();
+    EXPECT_FALSE(cfg_writer::to_text(bad, text));
+  }
+
   TEST(conf_parser, t_opts)
   {
     constexpr auto fname = "tests/cfg/parse_opt.txt"sv;
@@ -0,0 +1,289 @@
+#include "managers/logger.hpp"
+#include "alloc_count.hpp"
+using neko::logger;
+using neko::logging::kv;
+
+namespace neko_tests
+{
+  namespace detail
+  {
+    void post_messages(int count) noexcept
+    {
+      for (auto i = 0; i < count; ++i)
+      {
+        logger::note("Message {} of {}: {:.3f} {}", i, count, i * 0.5, "text"sv);
+        logger::warning("Warning {}", i, kv("index", i), kv("ok", i % 2 == 0));
+        logger::log<logger::category::config, logger::dbg>("Filtered {}", i);
+      }
+    }
+
+    //
+    // Minimal JSON validator
+    // Checks structure, escapes and UTF-8 of strings
+    //
+    class json_check
+    {
+    public:
+      explicit json_check(std::string_view text) noexcept :
+        m_text{ text }
+      { }
+
+      bool valid() noexcept
+      {
+        return value() && (ws(), m_pos == m_text.size());
+      }
+
+    private:
+      bool at_end() const noexcept
+      {
+        return m_pos >= m_text.size();
+      }
+      char cur() const noexcept
+      {
+        return at_end() ? '\0' : m_text[m_pos];
+      }
+      bool eat(char c) noexcept
+      {
+        ws();
+        if (cur() != c)
+          return false;
+
+        ++m_pos;
+        return true;
+      }
+      void ws() noexcept
+      {
+        while (!at_end() && (cur() == ' ' || cur() == '\t' || cur() == '\n' || cur() == '\r'))
+          ++m_pos;
+      }
+
+      bool value() noexcept
+      {
+        ws();
+        switch (cur())
+        {
+        case '{': return object();
+        case '[': return array();
+        case '"': return string();
+        case 't': return literal("true"sv);
+        case 'f': return literal("false"sv);
+        case 'n': return literal("null"sv);
+        default:  return number();
+        }
+      }
+
+      bool literal(std::string_view lit) noexcept
+      {
+        if (!m_text.substr(m_pos).starts_with(lit))
+          return false;
+
+        m_pos += lit.size();
+        return true;
+      }
+
+      bool number() noexcept
+      {
+        const auto start = m_pos;
+        while (!at_end() && std::string_view{ "+-.eE0123456789" }.find(cur()) != std::string_view::npos)
+          ++m_pos;
+
+        return m_pos != start;
+      }
+
+      bool object() noexcept
+      {
+        eat('{');
+        if (eat('}'))
+          return true;
+
+        do
+        {
+          ws();
+          if (!string() || !eat(':') || !value())
+            return false;
+        } while (eat(','));
+
+        return eat('}');
+      }
+
+      bool array() noexcept
+      {
+        eat('[');
+        if (eat(']'))
+          return true;
+
+        do
+        {
+          if (!value())
+            return false;
+        } while (eat(','));
+
+        return eat(']');
+      }
+
+      bool string() noexcept
+      {
+        if (cur() != '"')
+          return false;
+
+        for (++m_pos; !at_end(); ++m_pos)
+        {
+          const auto c = static_cast<unsigned char>(cur());
+          if (c == '"')
+          {
+            ++m_pos;
+            return true;
+          }
+
+          if (c < 0x20)
+            return false;
+
+          if (c == '\\')
+          {
+            ++m_pos;
+            if (cur() == 'u')
+            {
+              const auto hex = m_text.substr(m_pos + 1, 4);
+              if (hex.size() != 4 || !std::ranges::all_of(hex, [](char h) { return std::isxdigit(static_cast<unsigned char>(h)) != 0; }))
+                return false;
+
+              m_pos += 4;
+            }
+            else if (std::string_view{ "\"\\/bfnrt" }.find(cur()) == std::string_view::npos)
+            {
+              return false;
+            }
+            continue;
+          }
+
+          if (c >= 0x80)
+          {
+            const auto length = c >= 0xF0 ? 4u : c >= 0xE0 ? 3u : c >= 0xC0 ? 2u : 0u;
+            if (!length)
+              return false;
+
+            for (auto idx = 1u; idx < length; ++idx)
+            {
+              const auto next = static_cast<unsigned char>(m_text.size() > m_pos + idx ? m_text[m_pos + idx] : 0);
+              if ((next & 0xC0) != 0x80)
+                return false;
+            }
+            m_pos += length - 1;
+          }
+        }
+
+        return false;
+      }
+
+    private:
+      std::string_view m_text;
+      std::size_t m_pos{};
+    };
+  }
+
+  TEST(log, t_no_alloc)
+  {
+    constexpr auto fname = "tests/log_no_alloc.log"sv;
+    constexpr auto msgCount = 50;
+
+    logger::assign_file(fname);
+    logger::init();
+    ASSERT_TRUE(logger::good());
+
+    const auto prevLvl = logger::set_severity_level(logger::msg);
+    logger::set_rate_limit(0, {});
+
+    // Let everything which initialises lazily (time zone info, etc.) do so
+    detail::post_messages(1);
+
+    auto before = alloc_count();
+    detail::post_messages(msgCount);
+    EXPECT_EQ(before, alloc_count());
+
+    const auto prevOut = logger::set_output(logger::output::json);
+    before = alloc_count();
+    detail::post_messages(msgCount);
+    EXPECT_EQ(before, alloc_count());
+
+    logger::set_output(prevOut);
+    logger::set_severity_level(prevLvl);
+    logger::shutdown();
+  }
+
+  TEST(log, t_json_errors)
+  {
+    constexpr auto fname = "tests/log_json_errors.log"sv;
+
+    logger::assign_file(fname);
+    logger::init();
+    ASSERT_TRUE(logger::good());
+
+    const auto prevLvl = logger::set_severity_level(logger::msg);
+    const auto prevOut = logger::set_output(logger::output::json);
+    logger::set_rate_limit(0, {});
+
+    logger::note("Bad {:d} spec", "text"sv);
+    logger::note("Char {}", 'q', kv("quote", '"'));
+
+    logger::set_output(prevOut);
+    logger::set_severity_level(prevLvl);
+    logger::shutdown();
+
+    std::ifstream in{ fsys::path{ fname } };
+    std::vector<std::string> lines;
+    for (std::string line; std::getline(in, line); )
+    {
+      lines.emplace_back(std::move(line));
+    }
+
+    ASSERT_EQ(lines.size(), 2ull);
+    EXPECT_TRUE(lines[0].starts_with(R"({"time":")"));
+    EXPECT_NE(lines[0].find(R"("message":"Bad format string: )"), std::string::npos);
+    EXPECT_NE(lines[0].find(R"("fields":{"format":"Bad {:d} spec"}})"), std::string::npos);
+
+    EXPECT_NE(lines[1].find(R"("message":"Char q")"), std::string::npos);
+    EXPECT_NE(lines[1].find(R"("fields":{"quote":"\""}})"), std::string::npos);
+  }
+
+  TEST(log, t_json_long)
+  {
+    constexpr auto fname = "tests/log_json_long.log"sv;
+
+    logger::assign_file(fname);
+    logger::init();
+    ASSERT_TRUE(logger::good());
+
+    const auto prevLvl = logger::set_severity_level(logger::msg);
+    const auto prevOut = logger::set_output(logger::output::json);
+    logger::set_rate_limit(0, {});
+
+    // Escapes and multibyte characters land at every possible cut point
+    constexpr auto unit = "ab\"\x01\xc3\xa9\xe2\x82\xac"sv;
+    const auto first = 1024 / unit.size() - 20;
+    const auto last = 1024 / unit.size() + 20;
+    std::string text;
+    for (auto count = first; count < last; ++count)
+    {
+      text.clear();
+      for (auto idx = 0ull; idx < count; ++idx)
+        text += unit;
+
+      logger::note("Long {}", text, kv("index", count));
+      logger::note("Long field", kv("text", text), kv("index", count));
+    }
+
+    logger::set_output(prevOut);
+    logger::set_severity_level(prevLvl);
+    logger::shutdown();
+
+    std::ifstream in{ fsys::path{ fname }, std::ios::binary };
+    auto lineCount = 0ull;
+    for (std::string line; std::getline(in, line); ++lineCount)
+    {
+      EXPECT_LT(line.size(), 1024ull);
+      EXPECT_TRUE(detail::json_check{ line }.valid()) << line;
+      EXPECT_TRUE(line.ends_with("}}"sv)) << line;
+    }
+    EXPECT_EQ(lineCount, (last - first) * 2);
+  }
+}